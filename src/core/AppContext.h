@@ -1,18 +1,43 @@
 #ifndef CORE_APP_CONTEXT_H
 #define CORE_APP_CONTEXT_H
 
-#include <SDL3_mixer/SDL_mixer.h>
+#include "rmlui/RmlUi_FileInterface_Assets.h"
 #include "rmlui/RmlUi_Platform_SDL.h"
 #include "rmlui/RmlUi_Renderer_SDL.h"
+#include "rmlui/RmlUi_Renderer_Software.h"
+#include "core/assets/AssetPack.h"
+#include "core/input/Input.h"
+#include "core/audio/SfxMixer.h"
+#include "core/audio/MusicPlayer.h"
+#include "core/jobs/Scheduler.h"
+#include "core/memory/DeferredRelease.h"
+#include "core/memory/FrameArena.h"
+#include "core/render/RenderQueue.h"
+#include "core/render/SvgCache.h"
+#include "core/render/TextureManager.h"
 
 struct AppContext {
     SDL_Window* window{nullptr};
     SDL_Renderer* renderer{nullptr};
     SDL_AudioDeviceID audioDevice{};
     SDL_AppResult app_quit{SDL_APP_CONTINUE};
+    int outputWidth{0};  ///< Render output size in pixels, refreshed by the main loop when the window is resized.
+    int outputHeight{0};
     RenderInterface_SDL* render_interface{nullptr};
+    RenderInterface_Software* software_interface{nullptr}; ///< Renders the UI instead of render_interface on CPU-only machines.
     SystemInterface_SDL* system_interface{nullptr};
+    FileInterface_Assets* file_interface{nullptr};
     Rml::Context *context;
+    core::input::Manager *input{nullptr};
+    core::audio::SfxMixer *sfx{nullptr};
+    core::audio::MusicPlayer *music{nullptr};
+    core::jobs::Scheduler *jobs{nullptr}; ///< Worker threads shared by the engine, see Scheduler.h.
+    core::assets::AssetPack *assets{nullptr}; ///< Mounted asset pack, empty when running from loose files.
+    core::memory::FrameArena *frameArena{nullptr}; ///< Scratch memory, reset at the end of every frame.
+    core::memory::DeferredReleaseQueue *releases{nullptr}; ///< Resources to free in small slices at the end of frames.
+    core::render::RenderQueue *renderQueue{nullptr}; ///< Scenes record their frame here instead of using the renderer.
+    core::render::TextureManager *textures{nullptr}; ///< Owns scene and UI textures, evicts them over the memory budget.
+    core::render::SvgCache *svgs{nullptr}; ///< SVG rasters at their on-screen size, shared by the scenes.
     // Otros recursos globales que desees...
 };
 
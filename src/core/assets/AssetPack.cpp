@@ -0,0 +1,238 @@
+#include "core/assets/AssetPack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif (defined(__unix__) || defined(__APPLE__)) && !defined(__ANDROID__) && !defined(__EMSCRIPTEN__)
+#define CORE_ASSETS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace core::assets
+{
+
+    static const AssetPack *mountedPack = nullptr;
+
+    AssetPack::~AssetPack()
+    {
+        Close();
+    }
+
+    bool AssetPack::Open(const std::string &path)
+    {
+        Close();
+
+#if defined(_WIN32)
+        const int wideLength = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+        std::wstring widePath(wideLength, L'\0');
+        MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, widePath.data(), wideLength);
+
+        HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            SDL_SetError("couldn't open %s", path.c_str());
+            return false;
+        }
+        LARGE_INTEGER fileSize{};
+        HANDLE mapping = GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0
+                             ? CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr)
+                             : nullptr;
+        const void *view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view)
+        {
+            if (mapping)
+                CloseHandle(mapping);
+            CloseHandle(file);
+            SDL_SetError("couldn't map %s", path.c_str());
+            return false;
+        }
+        fileHandle = file;
+        mappingHandle = mapping;
+        data = static_cast<const Uint8 *>(view);
+        size = static_cast<size_t>(fileSize.QuadPart);
+        mapped = true;
+#elif defined(CORE_ASSETS_MMAP)
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            SDL_SetError("couldn't open %s", path.c_str());
+            return false;
+        }
+        struct stat info{};
+        void *view = fstat(fd, &info) == 0 && info.st_size > 0 ? mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        close(fd); // The mapping keeps the file alive.
+        if (view == MAP_FAILED)
+        {
+            SDL_SetError("couldn't map %s", path.c_str());
+            return false;
+        }
+        data = static_cast<const Uint8 *>(view);
+        size = static_cast<size_t>(info.st_size);
+        mapped = true;
+#else
+        // No mappable file (APK assets, Emscripten's virtual filesystem): read the pack once instead.
+        data = static_cast<const Uint8 *>(SDL_LoadFile(path.c_str(), &size));
+        if (!data)
+            return false;
+        mapped = false;
+#endif
+
+        if (!Validate())
+        {
+            SDL_SetError("%s is not a valid asset pack", path.c_str());
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void AssetPack::Close()
+    {
+        if (!data)
+            return;
+
+        if (mapped)
+        {
+#if defined(_WIN32)
+            UnmapViewOfFile(data);
+            CloseHandle(mappingHandle);
+            CloseHandle(fileHandle);
+            mappingHandle = fileHandle = nullptr;
+#elif defined(CORE_ASSETS_MMAP)
+            munmap(const_cast<Uint8 *>(data), size);
+#endif
+        }
+        else
+        {
+            SDL_free(const_cast<Uint8 *>(data));
+        }
+
+        data = nullptr;
+        size = 0;
+        header = nullptr;
+        index = nullptr;
+        names = nullptr;
+    }
+
+    bool AssetPack::Validate()
+    {
+        if (size < sizeof(pack::Header))
+            return false;
+
+        header = reinterpret_cast<const pack::Header *>(data);
+        if (std::memcmp(header->magic, pack::MAGIC, sizeof(pack::MAGIC)) != 0 || header->version != pack::VERSION)
+            return false;
+
+        const Uint64 indexSize = static_cast<Uint64>(header->entryCount) * sizeof(pack::Entry);
+        if (header->indexOffset % alignof(pack::Entry) != 0 || header->indexOffset > size || indexSize > size - header->indexOffset ||
+            header->namesOffset > size || header->namesSize > size - header->namesOffset)
+            return false;
+
+        index = reinterpret_cast<const pack::Entry *>(data + header->indexOffset);
+        names = reinterpret_cast<const char *>(data + header->namesOffset);
+        for (Uint32 i = 0; i < header->entryCount; i++)
+        {
+            const pack::Entry &entry = index[i];
+            if (entry.offset > size || entry.size > size - entry.offset ||
+                static_cast<Uint64>(entry.nameOffset) + entry.nameLength > header->namesSize ||
+                (i > 0 && index[i - 1].hash > entry.hash))
+                return false;
+        }
+        return true;
+    }
+
+    std::span<const Uint8> AssetPack::Find(std::string_view name) const
+    {
+        if (!index)
+            return {};
+
+        const Uint64 hash = pack::HashName(name);
+        const pack::Entry *end = index + header->entryCount;
+        const pack::Entry *entry = std::lower_bound(index, end, hash, [](const pack::Entry &entry, Uint64 hash)
+                                                    { return entry.hash < hash; });
+        for (; entry != end && entry->hash == hash; ++entry)
+        {
+            if (std::string_view(names + entry->nameOffset, entry->nameLength) == name)
+                return {data + entry->offset, static_cast<size_t>(entry->size)};
+        }
+        return {};
+    }
+
+    SDL_IOStream *AssetPack::OpenIO(std::string_view name) const
+    {
+        const std::span<const Uint8> file = Find(name);
+        if (file.data() == nullptr)
+            return nullptr;
+        return SDL_IOFromConstMem(file.data(), file.size());
+    }
+
+    std::string NormalizePath(std::string_view path)
+    {
+        std::string result(path);
+        std::replace(result.begin(), result.end(), '\\', '/');
+
+        static const std::string basePath = []
+        {
+            const char *base = SDL_GetBasePath();
+            std::string normalized = base ? base : "";
+            std::replace(normalized.begin(), normalized.end(), '\\', '/');
+            return normalized;
+        }();
+        if (!basePath.empty() && result.starts_with(basePath))
+            result.erase(0, basePath.size());
+
+        const bool absolute = result.starts_with('/');
+        std::vector<std::string_view> segments;
+        std::string_view rest = result;
+        while (!rest.empty())
+        {
+            const size_t slash = rest.find('/');
+            const std::string_view segment = rest.substr(0, slash);
+            rest = slash == std::string_view::npos ? std::string_view{} : rest.substr(slash + 1);
+
+            if (segment.empty() || segment == ".")
+                continue;
+            if (segment == ".." && !segments.empty() && segments.back() != "..")
+                segments.pop_back();
+            else
+                segments.push_back(segment);
+        }
+
+        std::string normalized = absolute ? "/" : "";
+        for (size_t i = 0; i < segments.size(); i++)
+        {
+            if (i > 0)
+                normalized += '/';
+            normalized += segments[i];
+        }
+        return normalized;
+    }
+
+    void Mount(const AssetPack *pack)
+    {
+        mountedPack = pack;
+    }
+
+    SDL_IOStream *OpenAsset(const std::string &path)
+    {
+        if (mountedPack)
+        {
+            if (SDL_IOStream *io = mountedPack->OpenIO(NormalizePath(path)))
+                return io;
+        }
+        return SDL_IOFromFile(path.c_str(), "rb");
+    }
+
+    std::span<const Uint8> FindAsset(const std::string &path)
+    {
+        return mountedPack ? mountedPack->Find(NormalizePath(path)) : std::span<const Uint8>{};
+    }
+
+} // namespace core::assets
@@ -0,0 +1,98 @@
+#ifndef CORE_ASSETS_ASSET_PACK_H
+#define CORE_ASSETS_ASSET_PACK_H
+
+#include <SDL3/SDL.h>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "core/assets/PackFormat.h"
+
+namespace core::assets
+{
+
+    /**
+     * @brief Read-only view of an asset pack built by tools/assetpack.
+     *
+     * The file is memory-mapped where the platform allows it, and read into memory once
+     * otherwise (Android assets, Emscripten). Lookups return spans into the mapping, so
+     * nothing is copied until a decoder reads it. The pack may be used from any thread once
+     * opened.
+     */
+    class AssetPack
+    {
+    public:
+        AssetPack() = default;
+        ~AssetPack();
+
+        /// Non-copyable
+        AssetPack(const AssetPack &) = delete;
+        AssetPack &operator=(const AssetPack &) = delete;
+
+        /**
+         * @brief Maps the pack and validates its header and index.
+         * @return false if the file is missing or malformed; the pack then stays empty.
+         */
+        bool Open(const std::string &path);
+        void Close();
+
+        bool IsOpen() const { return data != nullptr; }
+        Uint32 GetEntryCount() const { return header ? header->entryCount : 0; }
+
+        /**
+         * @brief Data of a packed file, empty if it is not in the pack.
+         * @param name Normalized name, see NormalizePath().
+         */
+        std::span<const Uint8> Find(std::string_view name) const;
+
+        /**
+         * @brief Read-only stream over a packed file, or nullptr. Closing it leaves the pack open.
+         */
+        SDL_IOStream *OpenIO(std::string_view name) const;
+
+    private:
+        const Uint8 *data{nullptr};
+        size_t size{0};
+        const pack::Header *header{nullptr};
+        const pack::Entry *index{nullptr};
+        const char *names{nullptr};
+
+        // How `data` was obtained, to release it the same way.
+        bool mapped{false};
+#ifdef _WIN32
+        void *fileHandle{nullptr};
+        void *mappingHandle{nullptr};
+#endif
+
+        bool Validate();
+    };
+
+    /**
+     * @brief Turns a path as used by the game into a pack name.
+     *
+     * Strips SDL_GetBasePath(), uses '/' separators and resolves "." and ".." segments, so that
+     * "C:\\game\\resources\\ui\\..\\ball.png" and "resources/ball.png" both become "resources/ball.png".
+     */
+    std::string NormalizePath(std::string_view path);
+
+    /**
+     * @brief Makes `pack` the source of OpenAsset(); nullptr goes back to loose files only.
+     * Not synchronized: mount before starting threads that load assets.
+     */
+    void Mount(const AssetPack *pack);
+
+    /**
+     * @brief Opens an asset from the mounted pack, or from the filesystem when it isn't packed.
+     * @return A stream to close with SDL_CloseIO(), or nullptr with SDL_GetError() set.
+     */
+    SDL_IOStream *OpenAsset(const std::string &path);
+
+    /**
+     * @brief Data of an asset in the mounted pack, without a stream or a copy.
+     * @return An empty span if nothing is mounted or the asset is not packed.
+     */
+    std::span<const Uint8> FindAsset(const std::string &path);
+
+} // namespace core::assets
+
+#endif // CORE_ASSETS_ASSET_PACK_H
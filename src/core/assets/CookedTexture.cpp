@@ -0,0 +1,121 @@
+#include "core/assets/CookedTexture.h"
+#include "core/assets/AssetPack.h"
+#include "core/render/CompactTextures.h"
+
+#include <cstring>
+
+namespace core::assets
+{
+
+    static bool IsValid(std::span<const Uint8> file)
+    {
+        if (file.size() < sizeof(texture::Header))
+            return false;
+
+        const texture::Header &header = *reinterpret_cast<const texture::Header *>(file.data());
+        if (std::memcmp(header.magic, texture::MAGIC, sizeof(texture::MAGIC)) != 0 || header.version != texture::VERSION)
+            return false;
+
+        const SDL_PixelFormat format = static_cast<SDL_PixelFormat>(header.format);
+        if (header.width == 0 || header.height == 0 || SDL_ISPIXELFORMAT_FOURCC(format) || SDL_BYTESPERPIXEL(format) == 0 ||
+            header.pitch < static_cast<Uint64>(header.width) * SDL_BYTESPERPIXEL(format))
+            return false;
+
+        return header.dataOffset >= sizeof(texture::Header) && header.dataOffset <= file.size() &&
+               static_cast<Uint64>(header.pitch) * header.height <= file.size() - header.dataOffset;
+    }
+
+    CookedTexture::~CookedTexture()
+    {
+        SDL_free(buffer);
+    }
+
+    bool CookedTexture::Open(const std::string &path)
+    {
+        const std::string cookedPath = path + texture::EXTENSION;
+        const std::span<const Uint8> packed = FindAsset(cookedPath);
+        if (packed.data() == nullptr)
+            return OpenFile(cookedPath); // A loose .rtex is optional, its absence is not an error.
+
+        Reset();
+        return Use(packed, cookedPath);
+    }
+
+    bool CookedTexture::OpenFile(const std::string &file)
+    {
+        Reset();
+        size_t size = 0;
+        buffer = SDL_LoadFile(file.c_str(), &size);
+        if (!buffer)
+            return false;
+        return Use({static_cast<const Uint8 *>(buffer), size}, file);
+    }
+
+    void CookedTexture::Reset()
+    {
+        SDL_free(buffer);
+        buffer = nullptr;
+        header = nullptr;
+    }
+
+    bool CookedTexture::Use(std::span<const Uint8> file, const std::string &name)
+    {
+        if (!IsValid(file))
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "CookedTexture: ignoring malformed %s", name.c_str());
+            Reset();
+            return false;
+        }
+
+        header = reinterpret_cast<const texture::Header *>(file.data());
+        return true;
+    }
+
+    SDL_Texture *CookedTexture::CreateTexture(SDL_Renderer *renderer) const
+    {
+        SDL_Texture *texture;
+        if (GetFormat() == SDL_PIXELFORMAT_RGBA32)
+        {
+            texture = render::compact::CreateTexture(renderer, GetPixels(), GetWidth(), GetHeight(), GetPitch());
+        }
+        else
+        {
+            texture = SDL_CreateTexture(renderer, GetFormat(), SDL_TEXTUREACCESS_STATIC, GetWidth(), GetHeight());
+            if (texture && !SDL_UpdateTexture(texture, nullptr, GetPixels(), GetPitch()))
+            {
+                SDL_DestroyTexture(texture);
+                texture = nullptr;
+            }
+        }
+        if (!texture)
+            return nullptr;
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+        return texture;
+    }
+
+    bool CookedTexture::Write(const std::string &file, int width, int height, const Uint8 *pixels)
+    {
+        texture::Header header{};
+        std::memcpy(header.magic, texture::MAGIC, sizeof(texture::MAGIC));
+        header.version = texture::VERSION;
+        header.width = static_cast<Uint32>(width);
+        header.height = static_cast<Uint32>(height);
+        header.format = SDL_PIXELFORMAT_RGBA32;
+        header.pitch = header.width * 4;
+        header.dataOffset = texture::DATA_ALIGNMENT;
+
+        SDL_IOStream *io = SDL_IOFromFile(file.c_str(), "wb");
+        if (!io)
+            return false;
+
+        static const Uint8 zeros[texture::DATA_ALIGNMENT] = {};
+        const size_t pixelBytes = static_cast<size_t>(header.pitch) * header.height;
+        bool written = SDL_WriteIO(io, &header, sizeof(header)) == sizeof(header) &&
+                       SDL_WriteIO(io, zeros, header.dataOffset - sizeof(header)) == header.dataOffset - sizeof(header) &&
+                       SDL_WriteIO(io, pixels, pixelBytes) == pixelBytes;
+        if (!SDL_CloseIO(io))
+            written = false;
+        return written;
+    }
+
+} // namespace core::assets
@@ -0,0 +1,70 @@
+#ifndef CORE_ASSETS_COOKED_TEXTURE_H
+#define CORE_ASSETS_COOKED_TEXTURE_H
+
+#include <SDL3/SDL.h>
+#include <span>
+#include <string>
+
+#include "core/assets/TextureFormat.h"
+
+namespace core::assets
+{
+
+    /**
+     * @brief Pixels of an image cooked by tools/texcook, see TextureFormat.h.
+     *
+     * When the texture is in the mounted pack the pixels point into the mapping and nothing is
+     * copied; a loose .rtex file is read into memory once. Either way there is no decoding or
+     * conversion left to do: the pixels are premultiplied and laid out as the header says.
+     */
+    class CookedTexture
+    {
+    public:
+        CookedTexture() = default;
+        ~CookedTexture();
+
+        /// Non-copyable
+        CookedTexture(const CookedTexture &) = delete;
+        CookedTexture &operator=(const CookedTexture &) = delete;
+
+        /**
+         * @brief Looks for the cooked version of `path`, i.e. `path` + ".rtex".
+         * @return false if there is none, or if it is malformed (which is logged); load `path` itself then.
+         */
+        bool Open(const std::string &path);
+
+        /**
+         * @brief Reads a .rtex file from the filesystem, e.g. a runtime cache. The pack is not searched.
+         */
+        bool OpenFile(const std::string &file);
+
+        int GetWidth() const { return static_cast<int>(header->width); }
+        int GetHeight() const { return static_cast<int>(header->height); }
+        int GetPitch() const { return static_cast<int>(header->pitch); }
+        SDL_PixelFormat GetFormat() const { return static_cast<SDL_PixelFormat>(header->format); }
+        const Uint8 *GetPixels() const { return reinterpret_cast<const Uint8 *>(header) + header->dataOffset; }
+
+        /**
+         * @brief Uploads the pixels into a new static texture with premultiplied alpha blending, in a
+         * 16-bit format if compact textures are enabled and the image allows it.
+         * The caller holds the RenderLock. @return nullptr with SDL_GetError() set on failure.
+         */
+        SDL_Texture *CreateTexture(SDL_Renderer *renderer) const;
+
+        /**
+         * @brief Writes premultiplied RGBA32 pixels as a .rtex file, the inverse of OpenFile().
+         * @return false with SDL_GetError() set on failure.
+         */
+        static bool Write(const std::string &file, int width, int height, const Uint8 *pixels);
+
+    private:
+        const texture::Header *header{nullptr};
+        void *buffer{nullptr}; ///< Owned copy of a loose file, null when mapped from the pack.
+
+        void Reset();
+        bool Use(std::span<const Uint8> file, const std::string &name);
+    };
+
+} // namespace core::assets
+
+#endif // CORE_ASSETS_COOKED_TEXTURE_H
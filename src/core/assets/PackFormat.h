@@ -0,0 +1,62 @@
+#ifndef CORE_ASSETS_PACK_FORMAT_H
+#define CORE_ASSETS_PACK_FORMAT_H
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief On-disk layout of asset packs, shared by the runtime and tools/assetpack.
+ *
+ * A pack is a header, the file data, the index and the name table, in this order. The index
+ * is sorted by name hash so lookups are a binary search. Every file starts at a multiple of
+ * DATA_ALIGNMENT, so a mapped pack hands out data suitably aligned for any decoder.
+ *
+ * All integers are little-endian. This header depends on the standard library only, the
+ * packer runs on the build machine.
+ */
+namespace core::assets::pack
+{
+
+    inline constexpr char MAGIC[4] = {'P', 'A', 'K', '1'};
+    inline constexpr std::uint32_t VERSION = 1;
+    inline constexpr std::uint64_t DATA_ALIGNMENT = 64;
+
+    struct Header
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t entryCount;
+        std::uint32_t reserved;
+        std::uint64_t indexOffset; ///< Entry[entryCount]
+        std::uint64_t namesOffset; ///< Concatenated names, not null-terminated.
+        std::uint64_t namesSize;
+    };
+
+    struct Entry
+    {
+        std::uint64_t hash;   ///< HashName() of the name.
+        std::uint64_t offset; ///< From the start of the pack.
+        std::uint64_t size;
+        std::uint32_t nameOffset; ///< Into the name table.
+        std::uint32_t nameLength;
+    };
+
+    static_assert(sizeof(Header) == 40 && sizeof(Entry) == 32, "pack structures must not contain padding");
+
+    /**
+     * @brief FNV-1a of a normalized name: relative, '/' separators, no "." or ".." segments.
+     */
+    constexpr std::uint64_t HashName(std::string_view name)
+    {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        for (char c : name)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+} // namespace core::assets::pack
+
+#endif // CORE_ASSETS_PACK_FORMAT_H
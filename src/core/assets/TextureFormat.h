@@ -0,0 +1,40 @@
+#ifndef CORE_ASSETS_TEXTURE_FORMAT_H
+#define CORE_ASSETS_TEXTURE_FORMAT_H
+
+#include <cstdint>
+
+/**
+ * @brief On-disk layout of cooked textures, shared by the runtime and tools/texcook.
+ *
+ * A cooked texture is the decoded image of "name.png" (or .svg, ...) stored next to it as
+ * "name.png.rtex": a header followed by rows of premultiplied pixels, ready to be handed to
+ * SDL_UpdateTexture() straight from the asset pack mapping. The pixel data starts at
+ * `dataOffset`, which the cooker keeps a multiple of 64 like the pack's own file alignment.
+ *
+ * All integers are little-endian. This header depends on the standard library only.
+ */
+namespace core::assets::texture
+{
+
+    inline constexpr char MAGIC[4] = {'R', 'T', 'E', 'X'};
+    inline constexpr std::uint32_t VERSION = 1;
+    inline constexpr char EXTENSION[] = ".rtex";
+    inline constexpr std::uint32_t DATA_ALIGNMENT = 64;
+
+    struct Header
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t format;     ///< SDL_PixelFormat of the pixels.
+        std::uint32_t pitch;      ///< Bytes per row.
+        std::uint32_t dataOffset; ///< From the start of the file.
+        std::uint32_t reserved;
+    };
+
+    static_assert(sizeof(Header) == 32, "texture header must not contain padding");
+
+} // namespace core::assets::texture
+
+#endif // CORE_ASSETS_TEXTURE_FORMAT_H
@@ -0,0 +1,483 @@
+#include "core/audio/MusicPlayer.h"
+#include "core/memory/AllocationTracker.h"
+#include "core/assets/AssetPack.h"
+
+#include <algorithm>
+
+// stb_vorbis from external/stb, compiled into this file. Only the push API is used: the worker feeds
+// it from an SDL_IOStream through a fixed buffer, so the whole file never needs to be in memory.
+#define STB_VORBIS_NO_STDIO
+#define STB_VORBIS_NO_PULLDATA_API
+#include "stb_vorbis.c"
+
+namespace core::audio
+{
+
+    /// Decoded audio buffered per deck, in seconds. Covers hitches of the worker thread.
+    static constexpr float RING_SECONDS = 0.5f;
+    /// Compressed bytes read from the file at a time.
+    static constexpr size_t INPUT_CHUNK = 16 * 1024;
+    /// Upper bound for the Vorbis setup headers, which must fit in the input buffer at once.
+    static constexpr size_t MAX_INPUT_BYTES = 1024 * 1024;
+    /// Samples moved from the converter to the ring per step.
+    static constexpr size_t TRANSFER_SAMPLES = 4096;
+    /// Largest Vorbis block, in frames.
+    static constexpr size_t MAX_VORBIS_FRAMES = 8192;
+    /// Frames mixed per pass of the audio callback.
+    static constexpr int MIX_CHUNK_FRAMES = 1024;
+    /// How often the worker checks the rings when it has nothing else to do.
+    static constexpr Sint32 WORKER_PERIOD_MS = 10;
+    /// Milliseconds to wait for a deck to drain before giving up on a request.
+    static constexpr int CLAIM_ATTEMPTS = 250;
+
+    MusicPlayer::~MusicPlayer()
+    {
+        Close();
+    }
+
+    bool MusicPlayer::Open(SDL_AudioDeviceID device)
+    {
+        SDL_AudioSpec deviceSpec{};
+        if (!SDL_GetAudioDeviceFormat(device, &deviceSpec, nullptr))
+        {
+            return false;
+        }
+        spec = SDL_AudioSpec{SDL_AUDIO_F32, deviceSpec.channels, deviceSpec.freq};
+
+        for (Deck &deck : decks)
+        {
+            deck.ring.Reset(static_cast<size_t>(RING_SECONDS * spec.freq) * spec.channels);
+            deck.input.resize(INPUT_CHUNK * 4);
+            deck.converter = SDL_CreateAudioStream(&spec, &spec);
+            if (!deck.converter)
+            {
+                Close();
+                return false;
+            }
+        }
+        mixScratch.assign(static_cast<size_t>(MIX_CHUNK_FRAMES) * spec.channels, 0.0f);
+        deckScratch.assign(mixScratch.size(), 0.0f);
+        interleaved.resize(MAX_VORBIS_FRAMES * 8);
+        transfer.resize(TRANSFER_SAMPLES);
+
+        stream = SDL_CreateAudioStream(&spec, &spec);
+        mutex = SDL_CreateMutex();
+        wake = SDL_CreateCondition();
+        if (!stream || !mutex || !wake ||
+            !SDL_SetAudioStreamGetCallback(stream, OnAudioRequested, this) || !SDL_BindAudioStream(device, stream))
+        {
+            Close();
+            return false;
+        }
+
+        worker = SDL_CreateThread(WorkerMain, "music", this);
+        if (!worker)
+        {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void MusicPlayer::Close()
+    {
+        if (worker)
+        {
+            SDL_LockMutex(mutex);
+            commands.push_back(Command{Command::QUIT, {}, 0.0f, false});
+            SDL_SignalCondition(wake);
+            SDL_UnlockMutex(mutex);
+            SDL_WaitThread(worker, nullptr);
+            worker = nullptr;
+        }
+        if (stream)
+        {
+            SDL_DestroyAudioStream(stream);
+            stream = nullptr;
+        }
+        for (Deck &deck : decks)
+        {
+            CloseSource(deck);
+            if (deck.converter)
+            {
+                SDL_DestroyAudioStream(deck.converter);
+                deck.converter = nullptr;
+            }
+            deck.state.store(DECK_IDLE);
+        }
+        if (wake)
+        {
+            SDL_DestroyCondition(wake);
+            wake = nullptr;
+        }
+        if (mutex)
+        {
+            SDL_DestroyMutex(mutex);
+            mutex = nullptr;
+        }
+        commands.clear();
+    }
+
+    void MusicPlayer::Play(const std::string &path, float fadeSeconds, bool loop)
+    {
+        if (!worker)
+            return;
+
+        SDL_LockMutex(mutex);
+        commands.push_back(Command{Command::PLAY, path, fadeSeconds, loop});
+        SDL_SignalCondition(wake);
+        SDL_UnlockMutex(mutex);
+    }
+
+    void MusicPlayer::Stop(float fadeSeconds)
+    {
+        if (!worker)
+            return;
+
+        SDL_LockMutex(mutex);
+        commands.push_back(Command{Command::STOP, {}, fadeSeconds, false});
+        SDL_SignalCondition(wake);
+        SDL_UnlockMutex(mutex);
+    }
+
+    bool MusicPlayer::IsPlaying() const
+    {
+        return std::any_of(std::begin(decks), std::end(decks), [](const Deck &deck)
+                           { return deck.state.load(std::memory_order_acquire) != DECK_IDLE; });
+    }
+
+    float MusicPlayer::FadeStep(float fadeSeconds) const
+    {
+        return fadeSeconds > 0.0f ? 1.0f / (fadeSeconds * spec.freq) : 1.0f;
+    }
+
+    // Worker thread
+
+    int SDLCALL MusicPlayer::WorkerMain(void *userdata)
+    {
+        static_cast<MusicPlayer *>(userdata)->RunWorker();
+        return 0;
+    }
+
+    void MusicPlayer::RunWorker()
+    {
+        core::memory::tracking::SetThreadName("music");
+        for (;;)
+        {
+            SDL_LockMutex(mutex);
+            if (commands.empty())
+            {
+                SDL_WaitConditionTimeout(wake, mutex, WORKER_PERIOD_MS);
+            }
+            std::deque<Command> pending;
+            pending.swap(commands);
+            SDL_UnlockMutex(mutex);
+
+            for (const Command &command : pending)
+            {
+                if (command.type == Command::QUIT)
+                    return;
+                HandleCommand(command);
+            }
+
+            for (Deck &deck : decks)
+            {
+                // Fading decks are still fed, so the fade runs its full length on real audio.
+                const int state = deck.state.load(std::memory_order_acquire);
+                if (state == DECK_IDLE)
+                    CloseSource(deck);
+                else if (deck.vorbis)
+                    Fill(deck);
+            }
+        }
+    }
+
+    void MusicPlayer::HandleCommand(const Command &command)
+    {
+        FadeOutPlaying(command.fadeSeconds);
+        if (command.type != Command::PLAY)
+            return;
+
+        // Claim a silent deck. If both are still fading (very fast switching), cut the
+        // older one short and wait for the callback to drain it; this takes one device period.
+        Deck *target = nullptr;
+        for (int attempt = 0; !target; attempt++)
+        {
+            for (Deck &deck : decks)
+            {
+                if (deck.state.load(std::memory_order_acquire) == DECK_IDLE)
+                {
+                    target = &deck;
+                    break;
+                }
+            }
+            if (!target && attempt >= CLAIM_ATTEMPTS)
+            {
+                // The device is not pulling audio (paused or lost); drop the request.
+                SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Music: no free deck for %s", command.path.c_str());
+                return;
+            }
+            if (!target)
+            {
+                Deck &older = decks[0].startedAt <= decks[1].startedAt ? decks[0] : decks[1];
+                older.fadeStep.store(1.0f, std::memory_order_relaxed);
+                SDL_Delay(1);
+            }
+        }
+
+        // An idle deck belongs to the worker: the callback skips it until it is playing again.
+        CloseSource(*target);
+        target->ring.Discard();
+        if (!OpenSource(*target, command.path))
+            return;
+
+        target->loop = command.loop;
+        target->startedAt = SDL_GetTicksNS();
+        target->endOfStream.store(false, std::memory_order_relaxed);
+        target->targetGain.store(1.0f, std::memory_order_relaxed);
+        target->fadeStep.store(FadeStep(command.fadeSeconds), std::memory_order_relaxed);
+        target->state.store(DECK_PLAYING, std::memory_order_release);
+        Fill(*target);
+    }
+
+    void MusicPlayer::FadeOutPlaying(float fadeSeconds)
+    {
+        for (Deck &deck : decks)
+        {
+            if (deck.state.load(std::memory_order_acquire) != DECK_PLAYING)
+                continue;
+
+            deck.targetGain.store(0.0f, std::memory_order_relaxed);
+            deck.fadeStep.store(FadeStep(fadeSeconds), std::memory_order_relaxed);
+            int expected = DECK_PLAYING;
+            deck.state.compare_exchange_strong(expected, DECK_STOPPING, std::memory_order_acq_rel);
+        }
+    }
+
+    bool MusicPlayer::OpenSource(Deck &deck, const std::string &path)
+    {
+        deck.io = assets::OpenAsset(path);
+        if (!deck.io)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Failed to open music %s: %s", path.c_str(), SDL_GetError());
+            return false;
+        }
+
+        deck.inputStart = 0;
+        deck.inputEnd = 0;
+        deck.draining = false;
+        if (!OpenDecoder(deck))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Failed to decode music %s", path.c_str());
+            CloseSource(deck);
+            return false;
+        }
+
+        const stb_vorbis_info info = stb_vorbis_get_info(deck.vorbis);
+        const SDL_AudioSpec fileSpec{SDL_AUDIO_F32, info.channels, static_cast<int>(info.sample_rate)};
+        SDL_ClearAudioStream(deck.converter);
+        SDL_SetAudioStreamFormat(deck.converter, &fileSpec, &spec);
+        return true;
+    }
+
+    void MusicPlayer::CloseSource(Deck &deck)
+    {
+        if (deck.vorbis)
+        {
+            stb_vorbis_close(deck.vorbis);
+            deck.vorbis = nullptr;
+        }
+        if (deck.io)
+        {
+            SDL_CloseIO(deck.io);
+            deck.io = nullptr;
+        }
+    }
+
+    bool MusicPlayer::OpenDecoder(Deck &deck)
+    {
+        for (;;)
+        {
+            int used = 0;
+            int error = 0;
+            deck.vorbis = stb_vorbis_open_pushdata(deck.input.data() + deck.inputStart,
+                                                   static_cast<int>(deck.inputEnd - deck.inputStart), &used, &error, nullptr);
+            if (deck.vorbis)
+            {
+                deck.inputStart += used;
+                return true;
+            }
+            if (error != VORBIS_need_more_data)
+                return false;
+
+            // The setup headers must be contiguous; grow the buffer if they don't fit yet.
+            if (deck.inputStart == 0 && deck.inputEnd == deck.input.size())
+            {
+                if (deck.input.size() >= MAX_INPUT_BYTES)
+                    return false;
+                deck.input.resize(deck.input.size() * 2);
+            }
+            if (!Refill(deck))
+                return false;
+        }
+    }
+
+    bool MusicPlayer::Refill(Deck &deck)
+    {
+        // Compact what is left, then top the buffer up.
+        const size_t remaining = deck.inputEnd - deck.inputStart;
+        if (deck.inputStart > 0)
+        {
+            SDL_memmove(deck.input.data(), deck.input.data() + deck.inputStart, remaining);
+            deck.inputStart = 0;
+            deck.inputEnd = remaining;
+        }
+
+        const size_t space = deck.input.size() - deck.inputEnd;
+        if (space == 0)
+            return false;
+
+        const size_t read = SDL_ReadIO(deck.io, deck.input.data() + deck.inputEnd, SDL_min(space, INPUT_CHUNK));
+        deck.inputEnd += read;
+        return read > 0;
+    }
+
+    bool MusicPlayer::DecodeFrame(Deck &deck)
+    {
+        for (;;)
+        {
+            int channels = 0;
+            int frames = 0;
+            float **output = nullptr;
+            const int used = stb_vorbis_decode_frame_pushdata(deck.vorbis, deck.input.data() + deck.inputStart,
+                                                              static_cast<int>(deck.inputEnd - deck.inputStart),
+                                                              &channels, &output, &frames);
+            deck.inputStart += used;
+
+            if (used == 0 && frames == 0)
+            {
+                if (!Refill(deck))
+                    return false; // End of file.
+                continue;
+            }
+            if (frames == 0)
+                continue; // Resynchronizing after a gap in the stream.
+
+            const size_t count = static_cast<size_t>(frames) * channels;
+            if (interleaved.size() < count)
+                interleaved.resize(count);
+            for (int frame = 0; frame < frames; frame++)
+            {
+                for (int channel = 0; channel < channels; channel++)
+                    interleaved[static_cast<size_t>(frame) * channels + channel] = output[channel][frame];
+            }
+            SDL_PutAudioStreamData(deck.converter, interleaved.data(), static_cast<int>(count * sizeof(float)));
+            return true;
+        }
+    }
+
+    void MusicPlayer::Fill(Deck &deck)
+    {
+        const size_t transferSamples = transfer.size() - transfer.size() % spec.channels;
+        while (deck.ring.WriteAvailable() >= transferSamples)
+        {
+            const int bytes = SDL_GetAudioStreamData(deck.converter, transfer.data(), static_cast<int>(transferSamples * sizeof(float)));
+            if (bytes > 0)
+            {
+                deck.ring.Write(transfer.data(), bytes / sizeof(float));
+                continue;
+            }
+            if (deck.draining)
+            {
+                // Tail flushed out of the converter: the track is over.
+                CloseSource(deck);
+                deck.endOfStream.store(true, std::memory_order_release);
+                return;
+            }
+            if (DecodeFrame(deck))
+                continue;
+
+            if (deck.loop)
+            {
+                // Restart the decoder at the beginning. The ring still holds the end of the
+                // previous pass, so the loop point plays without a gap.
+                stb_vorbis_close(deck.vorbis);
+                deck.vorbis = nullptr;
+                deck.inputStart = 0;
+                deck.inputEnd = 0;
+                if (SDL_SeekIO(deck.io, 0, SDL_IO_SEEK_SET) == 0 && OpenDecoder(deck))
+                    continue;
+                SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Failed to loop music: %s", SDL_GetError());
+            }
+            SDL_FlushAudioStream(deck.converter);
+            deck.draining = true;
+        }
+    }
+
+    // Audio thread
+
+    void SDLCALL MusicPlayer::OnAudioRequested(void *userdata, SDL_AudioStream *stream, int additional, int total)
+    {
+        auto *player = static_cast<MusicPlayer *>(userdata);
+        int frames = additional / static_cast<int>(player->spec.channels * sizeof(float));
+        while (frames > 0)
+        {
+            const int chunk = SDL_min(frames, MIX_CHUNK_FRAMES);
+            player->Mix(chunk);
+            frames -= chunk;
+        }
+    }
+
+    void MusicPlayer::Mix(int frames)
+    {
+        const int channels = spec.channels;
+        const size_t count = static_cast<size_t>(frames) * channels;
+        float *out = mixScratch.data();
+        SDL_memset(out, 0, count * sizeof(float));
+        const float volume = masterVolume.load(std::memory_order_relaxed);
+
+        for (Deck &deck : decks)
+        {
+            const int state = deck.state.load(std::memory_order_acquire);
+            if (state == DECK_IDLE)
+                continue;
+
+            // Missing samples (worker still opening the file, or a hitch) play as silence.
+            const size_t read = deck.ring.Read(deckScratch.data(), count);
+            SDL_memset(deckScratch.data() + read, 0, (count - read) * sizeof(float));
+            const float target = deck.targetGain.load(std::memory_order_relaxed);
+            const float step = deck.fadeStep.load(std::memory_order_relaxed);
+
+            // A fade-out keeps time with the output even through an underrun, so it always ends;
+            // a fade-in waits for the first samples of its track.
+            const size_t fadeFrames = state == DECK_STOPPING ? static_cast<size_t>(frames) : read / channels;
+            for (size_t frame = 0; frame < fadeFrames; frame++)
+            {
+                if (deck.gain < target)
+                    deck.gain = SDL_min(deck.gain + step, target);
+                else if (deck.gain > target)
+                    deck.gain = SDL_max(deck.gain - step, target);
+
+                const float gain = deck.gain * volume;
+                for (int channel = 0; channel < channels; channel++)
+                {
+                    const size_t i = frame * channels + channel;
+                    out[i] += deckScratch[i] * gain;
+                }
+            }
+
+            const bool faded = state == DECK_STOPPING && deck.gain <= 0.0f;
+            const bool finished = read == 0 && deck.endOfStream.load(std::memory_order_acquire);
+            if (faded || finished)
+            {
+                deck.ring.Discard();
+                deck.gain = 0.0f;
+                int expected = state;
+                deck.state.compare_exchange_strong(expected, DECK_IDLE, std::memory_order_acq_rel);
+            }
+        }
+
+        SDL_PutAudioStreamData(stream, out, static_cast<int>(count * sizeof(float)));
+    }
+
+} // namespace core::audio
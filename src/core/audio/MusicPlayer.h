@@ -0,0 +1,150 @@
+#ifndef CORE_AUDIO_MUSIC_PLAYER_H
+#define CORE_AUDIO_MUSIC_PLAYER_H
+
+#include <SDL3/SDL.h>
+#include <atomic>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "core/audio/RingBuffer.h"
+
+struct stb_vorbis;
+
+namespace core::audio
+{
+
+    /**
+     * @brief Streams OGG Vorbis music from a background thread.
+     *
+     * Play() only queues a request, so it returns immediately. A worker thread opens the file,
+     * decodes it a few kilobytes at a time, converts it to the device format and fills a
+     * lock-free ring buffer; the audio callback reads from that ring and never waits on the
+     * worker. Two decks allow crossfading from one track to the next, and looping tracks
+     * restart decoding ahead of time so the loop point has no gap.
+     *
+     * Memory use is constant: a fixed input buffer, the decoder state and the ring per deck,
+     * regardless of track length.
+     */
+    class MusicPlayer
+    {
+    public:
+        MusicPlayer() = default;
+        ~MusicPlayer();
+
+        /// Non-copyable
+        MusicPlayer(const MusicPlayer &) = delete;
+        MusicPlayer &operator=(const MusicPlayer &) = delete;
+
+        /**
+         * @brief Binds the music stream to an open playback device and starts the worker.
+         * @return true on success; false otherwise (see SDL_GetError()).
+         */
+        bool Open(SDL_AudioDeviceID device);
+
+        /**
+         * @brief Stops the worker and unbinds the stream.
+         */
+        void Close();
+
+        /**
+         * @brief Starts a track, crossfading from whatever is playing.
+         * @param path OGG Vorbis file.
+         * @param fadeSeconds Length of the crossfade; 0 switches immediately.
+         * @param loop Restart seamlessly at the end of the track.
+         */
+        void Play(const std::string &path, float fadeSeconds = 0.0f, bool loop = true);
+
+        /**
+         * @brief Fades out and stops whatever is playing.
+         */
+        void Stop(float fadeSeconds = 0.0f);
+
+        /**
+         * @brief Linear gain applied to all music.
+         */
+        void SetVolume(float volume) { masterVolume.store(volume, std::memory_order_relaxed); }
+
+        /**
+         * @brief Returns true while any deck is producing sound.
+         */
+        bool IsPlaying() const;
+
+    private:
+        enum DeckState
+        {
+            DECK_IDLE,     ///< Silent and drained; only the worker may claim it.
+            DECK_PLAYING,  ///< Fed by the worker, audible.
+            DECK_STOPPING  ///< Still fed while the callback fades it out, then idle.
+        };
+
+        struct Deck
+        {
+            // Shared between the worker and the audio callback.
+            RingBuffer<float> ring;
+            std::atomic<int> state{DECK_IDLE};
+            std::atomic<float> targetGain{0.0f};
+            std::atomic<float> fadeStep{1.0f}; ///< Gain change per frame.
+            std::atomic<bool> endOfStream{false};
+
+            // Audio callback only.
+            float gain{0.0f};
+
+            // Worker only.
+            SDL_IOStream *io{nullptr};
+            stb_vorbis *vorbis{nullptr};
+            SDL_AudioStream *converter{nullptr};
+            std::vector<unsigned char> input;
+            size_t inputStart{0};
+            size_t inputEnd{0};
+            bool loop{false};
+            bool draining{false};
+            Uint64 startedAt{0};
+        };
+
+        struct Command
+        {
+            enum Type
+            {
+                PLAY,
+                STOP,
+                QUIT
+            } type;
+            std::string path;
+            float fadeSeconds;
+            bool loop;
+        };
+
+        SDL_AudioStream *stream{nullptr};
+        SDL_AudioSpec spec{};
+        Deck decks[2];
+        std::vector<float> mixScratch;
+        std::vector<float> deckScratch;
+        std::atomic<float> masterVolume{1.0f};
+
+        SDL_Thread *worker{nullptr};
+        SDL_Mutex *mutex{nullptr};
+        SDL_Condition *wake{nullptr};
+        std::deque<Command> commands;
+        std::vector<float> interleaved; ///< Worker scratch: one decoded Vorbis frame.
+        std::vector<float> transfer;    ///< Worker scratch: converter to ring.
+
+        static int SDLCALL WorkerMain(void *userdata);
+        void RunWorker();
+        void HandleCommand(const Command &command);
+        void FadeOutPlaying(float fadeSeconds);
+        bool OpenSource(Deck &deck, const std::string &path);
+        void CloseSource(Deck &deck);
+        bool OpenDecoder(Deck &deck);
+        bool Refill(Deck &deck);
+        bool DecodeFrame(Deck &deck);
+        void Fill(Deck &deck);
+        float FadeStep(float fadeSeconds) const;
+
+        static void SDLCALL OnAudioRequested(void *userdata, SDL_AudioStream *stream, int additional, int total);
+        void Mix(int frames);
+    };
+
+} // namespace core::audio
+
+#endif // CORE_AUDIO_MUSIC_PLAYER_H
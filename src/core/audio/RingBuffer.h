@@ -0,0 +1,114 @@
+#ifndef CORE_AUDIO_RING_BUFFER_H
+#define CORE_AUDIO_RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace core::audio
+{
+
+    /**
+     * @brief Lock-free single-producer, single-consumer ring of samples.
+     * One thread writes and one thread reads; neither ever blocks. The capacity is rounded
+     * up to a power of two and fixed at construction, so memory use stays constant.
+     */
+    template <typename T>
+    class RingBuffer
+    {
+    public:
+        explicit RingBuffer(size_t minCapacity = 0) { Reset(minCapacity); }
+
+        /// Non-copyable
+        RingBuffer(const RingBuffer &) = delete;
+        RingBuffer &operator=(const RingBuffer &) = delete;
+
+        /**
+         * @brief Reallocates the storage. Only valid while neither side is running.
+         */
+        void Reset(size_t minCapacity)
+        {
+            size_t capacity = 1;
+            while (capacity < minCapacity)
+                capacity <<= 1;
+            data.assign(minCapacity ? capacity : 0, T{});
+            mask = minCapacity ? capacity - 1 : 0;
+            head.store(0, std::memory_order_relaxed);
+            tail.store(0, std::memory_order_relaxed);
+        }
+
+        size_t Capacity() const { return data.size(); }
+
+        /// Producer side: free slots.
+        size_t WriteAvailable() const
+        {
+            return data.size() - (head.load(std::memory_order_relaxed) - tail.load(std::memory_order_acquire));
+        }
+
+        /// Consumer side: readable elements.
+        size_t ReadAvailable() const
+        {
+            return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Producer side: copies up to `count` elements in.
+         * @return Number of elements written.
+         */
+        size_t Write(const T *source, size_t count)
+        {
+            const size_t writeIndex = head.load(std::memory_order_relaxed);
+            count = count < WriteAvailable() ? count : WriteAvailable();
+            CopyIn(writeIndex, source, count);
+            head.store(writeIndex + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * @brief Consumer side: copies up to `count` elements out.
+         * @return Number of elements read.
+         */
+        size_t Read(T *destination, size_t count)
+        {
+            const size_t readIndex = tail.load(std::memory_order_relaxed);
+            count = count < ReadAvailable() ? count : ReadAvailable();
+            CopyOut(readIndex, destination, count);
+            tail.store(readIndex + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * @brief Consumer side: drops everything currently readable.
+         */
+        void Discard()
+        {
+            tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+        }
+
+    private:
+        std::vector<T> data;
+        size_t mask{0};
+        std::atomic<size_t> head{0}; ///< Total elements written; owned by the producer.
+        std::atomic<size_t> tail{0}; ///< Total elements read; owned by the consumer.
+
+        void CopyIn(size_t index, const T *source, size_t count)
+        {
+            const size_t start = index & mask;
+            const size_t first = count < data.size() - start ? count : data.size() - start;
+            std::memcpy(data.data() + start, source, first * sizeof(T));
+            std::memcpy(data.data(), source + first, (count - first) * sizeof(T));
+        }
+
+        void CopyOut(size_t index, T *destination, size_t count) const
+        {
+            const size_t start = index & mask;
+            const size_t first = count < data.size() - start ? count : data.size() - start;
+            std::memcpy(destination, data.data() + start, first * sizeof(T));
+            std::memcpy(destination + first, data.data(), (count - first) * sizeof(T));
+        }
+    };
+
+} // namespace core::audio
+
+#endif // CORE_AUDIO_RING_BUFFER_H
@@ -0,0 +1,354 @@
+#include "core/audio/SfxMixer.h"
+#include "core/assets/AssetPack.h"
+
+#include <algorithm>
+#include <string>
+
+#if defined(SDL_SSE_INTRINSICS)
+#include <xmmintrin.h>
+#elif defined(SDL_NEON_INTRINSICS)
+#include <arm_neon.h>
+#endif
+
+namespace core::audio
+{
+
+    /// Frames mixed per pass of the audio callback; larger requests are split.
+    static constexpr int MIX_CHUNK_FRAMES = 1024;
+
+    /// dst[i] += src[i] * gain
+    static void MixInto(float *dst, const float *src, size_t count, float gain)
+    {
+        size_t i = 0;
+#if defined(SDL_SSE_INTRINSICS)
+        const __m128 g = _mm_set1_ps(gain);
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 s = _mm_loadu_ps(src + i);
+            _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(s, g)));
+        }
+#elif defined(SDL_NEON_INTRINSICS)
+        const float32x4_t g = vdupq_n_f32(gain);
+        for (; i + 4 <= count; i += 4)
+        {
+            vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), g));
+        }
+#endif
+        for (; i < count; i++)
+        {
+            dst[i] += src[i] * gain;
+        }
+    }
+
+    /// Keeps stacked voices from wrapping around.
+    static void Clip(float *samples, size_t count)
+    {
+        size_t i = 0;
+#if defined(SDL_SSE_INTRINSICS)
+        const __m128 lo = _mm_set1_ps(-1.0f);
+        const __m128 hi = _mm_set1_ps(1.0f);
+        for (; i + 4 <= count; i += 4)
+        {
+            _mm_storeu_ps(samples + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(samples + i), lo), hi));
+        }
+#elif defined(SDL_NEON_INTRINSICS)
+        const float32x4_t lo = vdupq_n_f32(-1.0f);
+        const float32x4_t hi = vdupq_n_f32(1.0f);
+        for (; i + 4 <= count; i += 4)
+        {
+            vst1q_f32(samples + i, vminq_f32(vmaxq_f32(vld1q_f32(samples + i), lo), hi));
+        }
+#endif
+        for (; i < count; i++)
+        {
+            samples[i] = SDL_clamp(samples[i], -1.0f, 1.0f);
+        }
+    }
+
+    SfxMixer::~SfxMixer()
+    {
+        Close();
+    }
+
+    void SfxMixer::ApplyDeviceHints(const MixerConfig &config)
+    {
+        const std::string frames = std::to_string(config.bufferFrames);
+        SDL_SetHint(SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES, frames.c_str());
+    }
+
+    bool SfxMixer::Open(SDL_AudioDeviceID device, const MixerConfig &mixerConfig)
+    {
+        config = mixerConfig;
+
+        SDL_AudioSpec deviceSpec{};
+        if (!SDL_GetAudioDeviceFormat(device, &deviceSpec, &stats.deviceFrames))
+        {
+            return false;
+        }
+
+        // Mix in float at the device rate and layout so the stream never has to resample.
+        spec = SDL_AudioSpec{SDL_AUDIO_F32, deviceSpec.channels, deviceSpec.freq};
+        stats.frequency = spec.freq;
+
+        stream = SDL_CreateAudioStream(&spec, &spec);
+        if (!stream)
+        {
+            return false;
+        }
+
+        voices.assign(config.maxVoices, Voice{});
+        scratch.assign(static_cast<size_t>(MIX_CHUNK_FRAMES) * spec.channels, 0.0f);
+
+        if (!SDL_SetAudioStreamGetCallback(stream, OnAudioRequested, this) || !SDL_BindAudioStream(device, stream))
+        {
+            SDL_DestroyAudioStream(stream);
+            stream = nullptr;
+            return false;
+        }
+
+        SDL_Log("SFX mixer: %d Hz, %d channels, %d frame device buffer (%.1f ms)", spec.freq, spec.channels,
+                stats.deviceFrames, stats.deviceFrames * 1000.0f / spec.freq);
+        return true;
+    }
+
+    void SfxMixer::Close()
+    {
+        if (stream)
+        {
+            // Destroying a bound stream unbinds it and waits for the callback to finish.
+            SDL_DestroyAudioStream(stream);
+            stream = nullptr;
+        }
+        sounds.clear();
+        voices.clear();
+    }
+
+    SoundId SfxMixer::Load(const std::string &path)
+    {
+        if (!stream)
+        {
+            SDL_SetError("SFX mixer is not open");
+            SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Failed to load sound %s: %s", path.c_str(), SDL_GetError());
+            return INVALID_SOUND;
+        }
+
+        SDL_AudioSpec fileSpec{};
+        Uint8 *fileData = nullptr;
+        Uint32 fileLength = 0;
+        SDL_IOStream *io = assets::OpenAsset(path);
+        if (!io || !SDL_LoadWAV_IO(io, true, &fileSpec, &fileData, &fileLength))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Failed to load sound %s: %s", path.c_str(), SDL_GetError());
+            return INVALID_SOUND;
+        }
+
+        Uint8 *converted = nullptr;
+        int convertedLength = 0;
+        const bool ok = SDL_ConvertAudioSamples(&fileSpec, fileData, static_cast<int>(fileLength), &spec, &converted, &convertedLength);
+        SDL_free(fileData);
+        if (!ok)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Failed to convert sound %s: %s", path.c_str(), SDL_GetError());
+            return INVALID_SOUND;
+        }
+
+        std::vector<float> samples(convertedLength / sizeof(float));
+        SDL_memcpy(samples.data(), converted, samples.size() * sizeof(float));
+        SDL_free(converted);
+
+        SDL_LockAudioStream(stream);
+        SoundId id = INVALID_SOUND;
+        for (size_t i = 0; i < sounds.size(); i++)
+        {
+            if (!sounds[i].used)
+            {
+                id = static_cast<SoundId>(i);
+                break;
+            }
+        }
+        if (id == INVALID_SOUND)
+        {
+            id = static_cast<SoundId>(sounds.size());
+            sounds.emplace_back();
+        }
+        sounds[id].samples = std::move(samples);
+        sounds[id].used = true;
+        SDL_UnlockAudioStream(stream);
+
+        return id;
+    }
+
+    void SfxMixer::Unload(SoundId sound)
+    {
+        if (!stream || sound < 0 || sound >= static_cast<SoundId>(sounds.size()))
+            return;
+
+        std::vector<float> released;
+        SDL_LockAudioStream(stream);
+        for (Voice &voice : voices)
+        {
+            if (voice.sound == sound)
+                voice.sound = INVALID_SOUND;
+        }
+        released.swap(sounds[sound].samples);
+        sounds[sound].used = false;
+        SDL_UnlockAudioStream(stream);
+        // `released` is freed here, outside the lock.
+    }
+
+    void SfxMixer::Play(SoundId sound, float volume)
+    {
+        if (!stream || sound < 0 || sound >= static_cast<SoundId>(sounds.size()))
+            return;
+
+        SDL_LockAudioStream(stream);
+        if (!sounds[sound].used)
+        {
+            SDL_UnlockAudioStream(stream);
+            return;
+        }
+
+        // Drop triggers that would stack on an instance that has barely started.
+        const size_t dedupeSamples = static_cast<size_t>(config.dedupeWindowMs * 0.001f * spec.freq) * spec.channels;
+        for (const Voice &voice : voices)
+        {
+            if (voice.sound == sound && (voice.queuedAt != 0 || voice.position < dedupeSamples))
+            {
+                stats.deduplicated++;
+                SDL_UnlockAudioStream(stream);
+                return;
+            }
+        }
+
+        Voice *voice = AcquireVoice(sound);
+        voice->sound = sound;
+        voice->position = 0;
+        voice->gain = volume;
+        voice->order = nextOrder++;
+        voice->queuedAt = SDL_GetTicksNS();
+        stats.played++;
+        SDL_UnlockAudioStream(stream);
+    }
+
+    SfxMixer::Voice *SfxMixer::AcquireVoice(SoundId sound)
+    {
+        Voice *free = nullptr;
+        Voice *oldest = nullptr;
+        Voice *oldestOfSound = nullptr;
+        int instances = 0;
+
+        for (Voice &voice : voices)
+        {
+            if (voice.sound == INVALID_SOUND)
+            {
+                if (!free)
+                    free = &voice;
+                continue;
+            }
+            if (!oldest || voice.order < oldest->order)
+                oldest = &voice;
+            if (voice.sound == sound)
+            {
+                instances++;
+                if (!oldestOfSound || voice.order < oldestOfSound->order)
+                    oldestOfSound = &voice;
+            }
+        }
+
+        if (oldestOfSound && instances >= config.maxVoicesPerSound)
+        {
+            stats.stolen++;
+            return oldestOfSound;
+        }
+        if (free)
+            return free;
+
+        stats.stolen++;
+        return oldest;
+    }
+
+    bool SfxMixer::IsPlaying(SoundId sound) const
+    {
+        if (!stream)
+            return false;
+
+        SDL_LockAudioStream(stream);
+        const bool playing = std::any_of(voices.begin(), voices.end(), [sound](const Voice &voice)
+                                         { return voice.sound == sound; });
+        SDL_UnlockAudioStream(stream);
+        return playing;
+    }
+
+    void SfxMixer::SetMasterVolume(float volume)
+    {
+        if (!stream)
+            return;
+        SDL_LockAudioStream(stream);
+        masterVolume = volume;
+        SDL_UnlockAudioStream(stream);
+    }
+
+    MixerStats SfxMixer::GetStats() const
+    {
+        if (!stream)
+            return stats;
+
+        SDL_LockAudioStream(stream);
+        MixerStats result = stats;
+        result.activeVoices = static_cast<int>(std::count_if(voices.begin(), voices.end(), [](const Voice &voice)
+                                                             { return voice.sound != INVALID_SOUND; }));
+        const int queuedFrames = SDL_GetAudioStreamQueued(stream) / static_cast<int>(spec.channels * sizeof(float));
+        const float deviceMs = stats.deviceFrames * 1000.0f / spec.freq;
+        result.bufferLatencyMs = deviceMs + queuedFrames * 1000.0f / spec.freq;
+        result.outputLatencyMs = measuredMixDelayMs + deviceMs;
+        SDL_UnlockAudioStream(stream);
+        return result;
+    }
+
+    void SDLCALL SfxMixer::OnAudioRequested(void *userdata, SDL_AudioStream *stream, int additional, int total)
+    {
+        // Called on the audio thread with the stream lock held.
+        auto *mixer = static_cast<SfxMixer *>(userdata);
+        int frames = additional / static_cast<int>(mixer->spec.channels * sizeof(float));
+        while (frames > 0)
+        {
+            const int chunk = SDL_min(frames, MIX_CHUNK_FRAMES);
+            mixer->Mix(chunk);
+            frames -= chunk;
+        }
+    }
+
+    void SfxMixer::Mix(int frames)
+    {
+        const size_t count = static_cast<size_t>(frames) * spec.channels;
+        float *out = scratch.data();
+        SDL_memset(out, 0, count * sizeof(float));
+
+        const Uint64 now = SDL_GetTicksNS();
+        for (Voice &voice : voices)
+        {
+            if (voice.sound == INVALID_SOUND)
+                continue;
+
+            const std::vector<float> &samples = sounds[voice.sound].samples;
+            const size_t n = SDL_min(count, samples.size() - voice.position);
+
+            if (voice.queuedAt != 0)
+            {
+                // Moving average of the trigger-to-mix delay.
+                const float delayMs = (now - voice.queuedAt) / 1000000.0f;
+                measuredMixDelayMs = measuredMixDelayMs == 0.0f ? delayMs : measuredMixDelayMs * 0.9f + delayMs * 0.1f;
+                voice.queuedAt = 0;
+            }
+
+            MixInto(out, samples.data() + voice.position, n, voice.gain * masterVolume);
+            voice.position += n;
+            if (voice.position >= samples.size())
+                voice.sound = INVALID_SOUND;
+        }
+
+        Clip(out, count);
+        SDL_PutAudioStreamData(stream, out, static_cast<int>(count * sizeof(float)));
+    }
+
+} // namespace core::audio
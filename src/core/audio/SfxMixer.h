@@ -0,0 +1,138 @@
+#ifndef CORE_AUDIO_SFX_MIXER_H
+#define CORE_AUDIO_SFX_MIXER_H
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <vector>
+
+namespace core::audio
+{
+
+    /// Handle of a sound loaded into the mixer.
+    using SoundId = int;
+    inline constexpr SoundId INVALID_SOUND = -1;
+
+    /**
+     * @brief Settings of the sound effect mixer.
+     */
+    struct MixerConfig
+    {
+        int bufferFrames{256};        ///< Requested device buffer, in sample frames. Smaller means lower latency.
+        int maxVoices{16};            ///< Sounds that can play at the same time.
+        int maxVoicesPerSound{3};     ///< Instances of the same sound before the oldest one is stolen.
+        float dedupeWindowMs{15.0f};  ///< Triggers of a sound this close to a previous one are dropped.
+    };
+
+    /**
+     * @brief Runtime counters of the mixer.
+     */
+    struct MixerStats
+    {
+        int activeVoices{0};
+        Uint32 played{0};        ///< Accepted Play() calls.
+        Uint32 deduplicated{0};  ///< Play() calls dropped because the same sound had just started.
+        Uint32 stolen{0};        ///< Voices cut short to make room for a new one.
+        int deviceFrames{0};     ///< Buffer size the device actually uses.
+        int frequency{0};
+        float bufferLatencyMs{0.0f}; ///< Device buffer plus data queued in the stream.
+        float outputLatencyMs{0.0f}; ///< Measured from Play() until the voice is mixed, plus the device buffer.
+    };
+
+    /**
+     * @brief Small sound effect engine on top of an SDL_AudioStream.
+     *
+     * Samples are converted to the device format once, at load time, so the audio callback only
+     * adds float buffers together. Voices are a fixed pool: a sound triggered again within the
+     * dedupe window is dropped, a sound over its voice cap restarts its oldest voice, and a full
+     * pool steals the voice that has played the longest.
+     *
+     * All methods are called from the main thread; they synchronize with the audio thread
+     * through the stream lock.
+     */
+    class SfxMixer
+    {
+    public:
+        SfxMixer() = default;
+        ~SfxMixer();
+
+        /// Non-copyable
+        SfxMixer(const SfxMixer &) = delete;
+        SfxMixer &operator=(const SfxMixer &) = delete;
+
+        /**
+         * @brief Applies the requested buffer size. Must be called before the device is opened.
+         */
+        static void ApplyDeviceHints(const MixerConfig &config);
+
+        /**
+         * @brief Creates the mixing stream and binds it to an open playback device.
+         * @return true on success; false otherwise (see SDL_GetError()).
+         */
+        bool Open(SDL_AudioDeviceID device, const MixerConfig &config = {});
+
+        /**
+         * @brief Unbinds the stream and releases every sound.
+         */
+        void Close();
+
+        /**
+         * @brief Loads a WAV file and converts it to the mixing format.
+         * @return The sound handle, or INVALID_SOUND on failure.
+         */
+        SoundId Load(const std::string &path);
+
+        /**
+         * @brief Stops every voice of the sound and frees its samples.
+         */
+        void Unload(SoundId sound);
+
+        /**
+         * @brief Starts playing a sound.
+         * @param volume Linear gain applied to this instance.
+         */
+        void Play(SoundId sound, float volume = 1.0f);
+
+        /**
+         * @brief Returns true while at least one voice is playing the sound.
+         */
+        bool IsPlaying(SoundId sound) const;
+
+        void SetMasterVolume(float volume);
+
+        MixerStats GetStats() const;
+
+    private:
+        struct Sound
+        {
+            std::vector<float> samples; ///< Interleaved, in the mixing format.
+            bool used{false};
+        };
+
+        struct Voice
+        {
+            SoundId sound{INVALID_SOUND};
+            size_t position{0}; ///< Next sample to mix.
+            float gain{1.0f};
+            Uint64 order{0};     ///< Start sequence number, to find the oldest voice.
+            Uint64 queuedAt{0};  ///< SDL_GetTicksNS() of the Play() call; 0 once mixed.
+        };
+
+        SDL_AudioStream *stream{nullptr};
+        SDL_AudioSpec spec{};
+        MixerConfig config;
+        std::vector<Sound> sounds;
+        std::vector<Voice> voices;
+        std::vector<float> scratch;
+        float masterVolume{1.0f};
+        Uint64 nextOrder{1};
+        MixerStats stats;
+        float measuredMixDelayMs{0.0f};
+
+        static void SDLCALL OnAudioRequested(void *userdata, SDL_AudioStream *stream, int additional, int total);
+        void Mix(int frames);
+        Voice *AcquireVoice(SoundId sound);
+    };
+
+} // namespace core::audio
+
+#endif // CORE_AUDIO_SFX_MIXER_H
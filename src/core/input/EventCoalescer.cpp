@@ -0,0 +1,66 @@
+#include "core/input/EventCoalescer.h"
+
+namespace core::input
+{
+
+    /// Typical upper bound of events per frame; avoids growing the queues during play.
+    static constexpr size_t INITIAL_CAPACITY = 128;
+
+    EventCoalescer::EventCoalescer()
+    {
+        pending.reserve(INITIAL_CAPACITY);
+        draining.reserve(INITIAL_CAPACITY);
+    }
+
+    bool EventCoalescer::IsWindowStateEvent(Uint32 type)
+    {
+        switch (type)
+        {
+        case SDL_EVENT_WINDOW_RESIZED:
+        case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+        case SDL_EVENT_WINDOW_MOVED:
+        case SDL_EVENT_WINDOW_EXPOSED:
+        case SDL_EVENT_WINDOW_DISPLAY_SCALE_CHANGED:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    void EventCoalescer::Push(const SDL_Event &event)
+    {
+        current.received++;
+
+        if (IsWindowStateEvent(event.type))
+        {
+            // Only the final state matters: overwrite the pending event of the same kind.
+            for (SDL_Event &queued : pending)
+            {
+                if (queued.type == event.type && queued.window.windowID == event.window.windowID)
+                {
+                    queued = event;
+                    current.coalesced++;
+                    return;
+                }
+            }
+        }
+        else if (event.type == SDL_EVENT_MOUSE_MOTION && !pending.empty())
+        {
+            SDL_Event &last = pending.back();
+            if (last.type == SDL_EVENT_MOUSE_MOTION && last.motion.which == event.motion.which &&
+                last.motion.windowID == event.motion.windowID)
+            {
+                const float xrel = last.motion.xrel + event.motion.xrel;
+                const float yrel = last.motion.yrel + event.motion.yrel;
+                last = event;
+                last.motion.xrel = xrel;
+                last.motion.yrel = yrel;
+                current.coalesced++;
+                return;
+            }
+        }
+
+        pending.push_back(event);
+    }
+
+} // namespace core::input
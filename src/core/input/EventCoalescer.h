@@ -0,0 +1,86 @@
+#ifndef CORE_INPUT_EVENT_COALESCER_H
+#define CORE_INPUT_EVENT_COALESCER_H
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+namespace core::input
+{
+
+    /**
+     * @brief Buffers the events of one frame and merges redundant ones before dispatch.
+     *
+     * SDL delivers every event to SDL_AppEvent before calling SDL_AppIterate, so queueing them
+     * until the start of the iteration adds no latency. While queued:
+     * - Window size, move and scale events of the same window collapse into a single event that
+     *   keeps the latest values, so a drag-resize causes one relayout per frame.
+     * - Consecutive mouse motion events are merged into the last one, accumulating the relative
+     *   motion. A button, key or wheel event in between ends the run, so the pointer position seen
+     *   by every click is preserved.
+     * Every other event is kept in its original order.
+     */
+    class EventCoalescer
+    {
+    public:
+        struct Stats
+        {
+            Uint32 received{0};  ///< Events pushed during the last drained frame.
+            Uint32 delivered{0}; ///< Events handed to the dispatcher.
+            Uint32 coalesced{0}; ///< Events merged into an earlier one.
+        };
+
+        EventCoalescer();
+
+        /// Non-copyable
+        EventCoalescer(const EventCoalescer &) = delete;
+        EventCoalescer &operator=(const EventCoalescer &) = delete;
+
+        /**
+         * @brief Queues an event, merging it into a pending one when possible.
+         */
+        void Push(const SDL_Event &event);
+
+        /**
+         * @brief Delivers every queued event in order and empties the queue.
+         * Dispatching stops at the first handler result other than SDL_APP_CONTINUE;
+         * the remaining events are dropped since the application is shutting down.
+         * @param dispatch Callable taking `SDL_Event *` and returning SDL_AppResult.
+         */
+        template <typename Dispatch>
+        SDL_AppResult Drain(Dispatch &&dispatch)
+        {
+            // Handlers may push follow-up events; they land in the fresh queue for the next frame.
+            draining.swap(pending);
+            pending.clear();
+
+            lastStats = current;
+            lastStats.delivered = 0;
+            current = {};
+
+            SDL_AppResult result = SDL_APP_CONTINUE;
+            for (SDL_Event &event : draining)
+            {
+                lastStats.delivered++;
+                result = dispatch(&event);
+                if (result != SDL_APP_CONTINUE)
+                    break;
+            }
+            draining.clear();
+            return result;
+        }
+
+        /// Counters of the last drained frame.
+        const Stats &GetStats() const { return lastStats; }
+
+    private:
+        std::vector<SDL_Event> pending;
+        std::vector<SDL_Event> draining;
+        Stats current;
+        Stats lastStats;
+
+        static bool IsWindowStateEvent(Uint32 type);
+    };
+
+} // namespace core::input
+
+#endif // CORE_INPUT_EVENT_COALESCER_H
@@ -0,0 +1,260 @@
+#include "core/input/Input.h"
+
+namespace core::input
+{
+
+    /// Analog values at or above this count as the action being held.
+    static constexpr float PRESS_THRESHOLD = 0.5f;
+    /// Stick travel ignored around the rest position.
+    static constexpr float AXIS_DEADZONE = 0.25f;
+
+    static float NormalizeAxis(Sint16 raw, int sign)
+    {
+        float value = (raw / 32767.0f) * static_cast<float>(sign);
+        if (value < AXIS_DEADZONE)
+            return 0.0f;
+        return SDL_min(value, 1.0f);
+    }
+
+    Manager::~Manager()
+    {
+        for (SDL_Gamepad *gamepad : gamepads)
+        {
+            if (gamepad)
+                SDL_CloseGamepad(gamepad);
+        }
+    }
+
+    void Manager::Bind(ActionId action, Binding binding)
+    {
+        if (action < 0 || action >= MAX_ACTIONS)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Input: action %d is out of range", action);
+            return;
+        }
+        bindings.push_back({action, binding, 0.0f});
+    }
+
+    void Manager::ClearBindings(ActionId action)
+    {
+        std::erase_if(bindings, [action](const BoundInput &bound)
+                      { return bound.action == action; });
+        SetAction(action, 0.0f, SDL_GetTicksNS());
+    }
+
+    std::vector<Binding> Manager::GetBindings(ActionId action) const
+    {
+        std::vector<Binding> result;
+        for (const BoundInput &bound : bindings)
+        {
+            if (bound.action == action)
+                result.push_back(bound.binding);
+        }
+        return result;
+    }
+
+    void Manager::ProcessEvent(const SDL_Event &event)
+    {
+        switch (event.type)
+        {
+        case SDL_EVENT_KEY_DOWN:
+        case SDL_EVENT_KEY_UP:
+        {
+            if (event.key.repeat)
+                break;
+            const float value = event.type == SDL_EVENT_KEY_DOWN ? 1.0f : 0.0f;
+            for (BoundInput &bound : bindings)
+            {
+                if (bound.binding.kind == Binding::Kind::Key && bound.binding.code == event.key.scancode)
+                {
+                    bound.value = value;
+                    SetAction(bound.action, value, event.key.timestamp);
+                }
+            }
+            break;
+        }
+        case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+        case SDL_EVENT_GAMEPAD_BUTTON_UP:
+        {
+            const int slot = SlotOf(event.gbutton.which);
+            const float value = event.type == SDL_EVENT_GAMEPAD_BUTTON_DOWN ? 1.0f : 0.0f;
+            for (BoundInput &bound : bindings)
+            {
+                if (bound.binding.kind == Binding::Kind::GamepadButton && bound.binding.slot == slot &&
+                    bound.binding.code == event.gbutton.button)
+                {
+                    bound.value = value;
+                    SetAction(bound.action, value, event.gbutton.timestamp);
+                }
+            }
+            break;
+        }
+        case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+        {
+            const int slot = SlotOf(event.gaxis.which);
+            for (BoundInput &bound : bindings)
+            {
+                if (bound.binding.kind == Binding::Kind::GamepadAxis && bound.binding.slot == slot &&
+                    bound.binding.code == event.gaxis.axis)
+                {
+                    bound.value = NormalizeAxis(event.gaxis.value, bound.binding.axisSign);
+                    SetAction(bound.action, bound.value, event.gaxis.timestamp);
+                }
+            }
+            break;
+        }
+        case SDL_EVENT_GAMEPAD_ADDED:
+            OpenGamepad(event.gdevice.which);
+            break;
+        case SDL_EVENT_GAMEPAD_REMOVED:
+            CloseGamepad(event.gdevice.which);
+            break;
+        default:
+            break;
+        }
+    }
+
+    const Snapshot &Manager::BeginFrame()
+    {
+        if (lateSampling)
+        {
+            Resample();
+        }
+
+        snapshot.actions = live;
+        snapshot.frame++;
+        snapshot.sampledAt = SDL_GetTicksNS();
+
+        // Edges are latched until a frame has seen them.
+        for (ActionState &state : live)
+        {
+            state.pressed = false;
+            state.released = false;
+        }
+        return snapshot;
+    }
+
+    void Manager::SetAction(ActionId action, float value, Uint64 timestamp)
+    {
+        // The action follows the strongest of its bindings, so releasing one key
+        // does not cancel another one that is still held.
+        for (const BoundInput &bound : bindings)
+        {
+            if (bound.action == action)
+                value = SDL_max(value, bound.value);
+        }
+
+        ActionState &state = live[action];
+        const bool down = value >= PRESS_THRESHOLD;
+        if (down && !state.down)
+        {
+            state.pressed = true;
+            state.timestamp = timestamp;
+        }
+        else if (!down && state.down)
+        {
+            state.released = true;
+            state.timestamp = timestamp;
+        }
+        state.down = down;
+        state.value = value;
+    }
+
+    void Manager::Resample()
+    {
+        // Pull whatever the OS delivered since the event callbacks ran. The events stay
+        // queued and are seen again next frame, which is harmless: transitions are only
+        // reported when the state actually changes.
+        SDL_PumpEvents();
+        const bool *keyboard = SDL_GetKeyboardState(nullptr);
+        const Uint64 now = SDL_GetTicksNS();
+
+        for (BoundInput &bound : bindings)
+        {
+            bound.value = ReadBinding(bound.binding, keyboard);
+        }
+        for (ActionId action = 0; action < MAX_ACTIONS; action++)
+        {
+            SetAction(action, 0.0f, now);
+        }
+    }
+
+    float Manager::ReadBinding(const Binding &binding, const bool *keyboard) const
+    {
+        switch (binding.kind)
+        {
+        case Binding::Kind::Key:
+            return keyboard && binding.code >= 0 && binding.code < SDL_SCANCODE_COUNT && keyboard[binding.code] ? 1.0f : 0.0f;
+        case Binding::Kind::GamepadButton:
+        {
+            SDL_Gamepad *gamepad = binding.slot < static_cast<int>(gamepads.size()) ? gamepads[binding.slot] : nullptr;
+            return gamepad && SDL_GetGamepadButton(gamepad, static_cast<SDL_GamepadButton>(binding.code)) ? 1.0f : 0.0f;
+        }
+        case Binding::Kind::GamepadAxis:
+        {
+            SDL_Gamepad *gamepad = binding.slot < static_cast<int>(gamepads.size()) ? gamepads[binding.slot] : nullptr;
+            if (!gamepad)
+                return 0.0f;
+            return NormalizeAxis(SDL_GetGamepadAxis(gamepad, static_cast<SDL_GamepadAxis>(binding.code)), binding.axisSign);
+        }
+        }
+        return 0.0f;
+    }
+
+    void Manager::OpenGamepad(SDL_JoystickID id)
+    {
+        if (SlotOf(id) >= 0)
+            return;
+
+        SDL_Gamepad *gamepad = SDL_OpenGamepad(id);
+        if (!gamepad)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Input: couldn't open gamepad: %s", SDL_GetError());
+            return;
+        }
+
+        // Reuse the first free slot so players keep their slot when another pad is unplugged.
+        for (size_t slot = 0; slot < gamepads.size(); slot++)
+        {
+            if (!gamepads[slot])
+            {
+                gamepads[slot] = gamepad;
+                SDL_Log("Gamepad %s assigned to slot %zu", SDL_GetGamepadName(gamepad), slot);
+                return;
+            }
+        }
+        gamepads.push_back(gamepad);
+        SDL_Log("Gamepad %s assigned to slot %zu", SDL_GetGamepadName(gamepad), gamepads.size() - 1);
+    }
+
+    void Manager::CloseGamepad(SDL_JoystickID id)
+    {
+        const int slot = SlotOf(id);
+        if (slot < 0)
+            return;
+
+        SDL_CloseGamepad(gamepads[slot]);
+        gamepads[slot] = nullptr;
+
+        const Uint64 now = SDL_GetTicksNS();
+        for (BoundInput &bound : bindings)
+        {
+            if (bound.binding.kind != Binding::Kind::Key && bound.binding.slot == slot)
+            {
+                bound.value = 0.0f;
+                SetAction(bound.action, 0.0f, now);
+            }
+        }
+    }
+
+    int Manager::SlotOf(SDL_JoystickID id) const
+    {
+        for (size_t slot = 0; slot < gamepads.size(); slot++)
+        {
+            if (gamepads[slot] && SDL_GetGamepadID(gamepads[slot]) == id)
+                return static_cast<int>(slot);
+        }
+        return -1;
+    }
+
+} // namespace core::input
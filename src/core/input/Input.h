@@ -0,0 +1,169 @@
+#ifndef CORE_INPUT_INPUT_H
+#define CORE_INPUT_INPUT_H
+
+#include <SDL3/SDL.h>
+#include <array>
+#include <vector>
+
+namespace core::input
+{
+
+    /// Identifier of a logical action. Games define their own enum and cast it.
+    using ActionId = int;
+
+    /// Maximum number of actions that can be bound at the same time.
+    inline constexpr int MAX_ACTIONS = 32;
+
+    /**
+     * @brief Physical input that triggers an action.
+     * Gamepads are addressed by slot: 0 is the first connected gamepad, 1 the second, and so on.
+     */
+    struct Binding
+    {
+        enum class Kind
+        {
+            Key,           ///< Keyboard scancode.
+            GamepadButton, ///< SDL_GamepadButton on the gamepad in `slot`.
+            GamepadAxis    ///< SDL_GamepadAxis on the gamepad in `slot`, pushed towards `axisSign`.
+        };
+
+        Kind kind{Kind::Key};
+        int code{0};
+        int slot{0};
+        int axisSign{1};
+
+        static Binding Key(SDL_Scancode scancode) { return {Kind::Key, scancode, 0, 1}; }
+        static Binding Button(SDL_GamepadButton button, int slot = 0) { return {Kind::GamepadButton, button, slot, 1}; }
+        static Binding Axis(SDL_GamepadAxis axis, int sign, int slot = 0) { return {Kind::GamepadAxis, axis, slot, sign}; }
+    };
+
+    /// State of a single action as seen by a frame.
+    struct ActionState
+    {
+        bool down{false};     ///< Held at the time the snapshot was taken.
+        bool pressed{false};  ///< Went down at least once since the previous snapshot.
+        bool released{false}; ///< Went up at least once since the previous snapshot.
+        float value{0.0f};    ///< Analog value in [0, 1]; 1 or 0 for digital bindings.
+        Uint64 timestamp{0};  ///< SDL timestamp (ns) of the last transition.
+    };
+
+    /**
+     * @brief Immutable view of every action for one frame.
+     * Scenes read from it during Update instead of reacting to individual events,
+     * so all of them observe the same input for the whole frame.
+     */
+    class Snapshot
+    {
+    public:
+        bool IsDown(ActionId action) const { return Get(action).down; }
+        bool WasPressed(ActionId action) const { return Get(action).pressed; }
+        bool WasReleased(ActionId action) const { return Get(action).released; }
+        float Value(ActionId action) const { return Get(action).value; }
+        Uint64 Timestamp(ActionId action) const { return Get(action).timestamp; }
+
+        /// -1, 0 or 1 depending on which of the two actions is held.
+        int Axis(ActionId negative, ActionId positive) const
+        {
+            return (IsDown(positive) ? 1 : 0) - (IsDown(negative) ? 1 : 0);
+        }
+
+        /// Sequential frame number of this snapshot.
+        Uint64 Frame() const { return frame; }
+
+        /// SDL_GetTicksNS() at the moment the snapshot was published.
+        Uint64 SampledAt() const { return sampledAt; }
+
+    private:
+        friend class Manager;
+
+        const ActionState &Get(ActionId action) const
+        {
+            static const ActionState none{};
+            return (action >= 0 && action < MAX_ACTIONS) ? actions[action] : none;
+        }
+
+        std::array<ActionState, MAX_ACTIONS> actions{};
+        Uint64 frame{0};
+        Uint64 sampledAt{0};
+    };
+
+    /**
+     * @brief Maps keyboard and gamepad input to rebindable actions.
+     * Events are fed as they arrive; once per frame BeginFrame() publishes a Snapshot.
+     * With late sampling enabled, BeginFrame() pumps the OS queue and re-reads the device
+     * state right before the scenes update, so input that arrived during the previous
+     * frame's render is not delayed by one more frame.
+     */
+    class Manager
+    {
+    public:
+        Manager() = default;
+        ~Manager();
+
+        /// Non-copyable
+        Manager(const Manager &) = delete;
+        Manager &operator=(const Manager &) = delete;
+
+        /**
+         * @brief Adds a binding to an action. An action may have any number of bindings.
+         */
+        void Bind(ActionId action, Binding binding);
+
+        /**
+         * @brief Removes every binding of an action.
+         */
+        void ClearBindings(ActionId action);
+
+        /**
+         * @brief Returns the bindings currently assigned to an action.
+         */
+        std::vector<Binding> GetBindings(ActionId action) const;
+
+        /**
+         * @brief Enables re-sampling the device state right before Update.
+         */
+        void SetLateSampling(bool enabled) { lateSampling = enabled; }
+        bool IsLateSampling() const { return lateSampling; }
+
+        /**
+         * @brief Updates the live action state from an SDL event.
+         * Also opens and closes gamepads as they are connected.
+         */
+        void ProcessEvent(const SDL_Event &event);
+
+        /**
+         * @brief Publishes the snapshot for the frame that is about to be updated.
+         * @return The new snapshot, also available through Current().
+         */
+        const Snapshot &BeginFrame();
+
+        /**
+         * @brief Snapshot published by the last BeginFrame().
+         */
+        const Snapshot &Current() const { return snapshot; }
+
+    private:
+        struct BoundInput
+        {
+            ActionId action;
+            Binding binding;
+            float value; ///< Last value read from this binding.
+        };
+
+        std::vector<BoundInput> bindings;
+        std::vector<SDL_Gamepad *> gamepads; ///< Indexed by slot.
+        std::array<ActionState, MAX_ACTIONS> live{};
+        Snapshot snapshot;
+        bool lateSampling{true};
+
+        void SetAction(ActionId action, float value, Uint64 timestamp);
+        void Resample();
+        void OpenGamepad(SDL_JoystickID id);
+        void CloseGamepad(SDL_JoystickID id);
+        int SlotOf(SDL_JoystickID id) const;
+        float ReadBinding(const Binding &binding, const bool *keyboard) const;
+    };
+
+} // namespace core::input
+
+#endif // CORE_INPUT_INPUT_H
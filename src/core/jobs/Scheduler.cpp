@@ -0,0 +1,311 @@
+#include "core/jobs/Scheduler.h"
+#include "core/memory/AllocationTracker.h"
+
+namespace core::jobs
+{
+
+    /// The scheduler and slot of the calling worker thread.
+    static thread_local const Scheduler *currentScheduler = nullptr;
+    static thread_local int currentSlot = -1;
+
+    Scheduler::Scheduler(int workerCount)
+        : mainThread(SDL_GetCurrentThreadID())
+    {
+        if (workerCount < 0)
+            workerCount = std::max(SDL_GetNumLogicalCPUCores() - 1, 0);
+
+        sleepMutex = SDL_CreateMutex();
+        wake = SDL_CreateCondition();
+        if (!sleepMutex || !wake)
+            workerCount = 0;
+
+        for (int i = 0; i <= workerCount; i++)
+            slots.push_back(std::make_unique<Slot>());
+        // Threads keep a pointer to their entry.
+        workers.reserve(workerCount);
+        for (int i = 1; i <= workerCount; i++)
+        {
+            workers.push_back({this, i});
+            slots[i]->thread = SDL_CreateThread(WorkerMain, "jobs", &workers.back());
+            if (!slots[i]->thread)
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Scheduler: couldn't create a worker: %s", SDL_GetError());
+                workers.pop_back();
+                slots.resize(i);
+                break;
+            }
+        }
+    }
+
+    Scheduler::~Scheduler()
+    {
+        // Queued jobs still run; their counters may be waited on by the workers' own jobs.
+        Task task;
+        while (SDL_GetAtomicInt(&queued) > 0 || SDL_GetAtomicInt(&mainQueued) > 0)
+        {
+            if (PopMain(task) || Pop(0, task) || Steal(0, task))
+                Execute(task, 0);
+        }
+
+        if (sleepMutex)
+        {
+            SDL_LockMutex(sleepMutex);
+            quit = true;
+            SDL_BroadcastCondition(wake);
+            SDL_UnlockMutex(sleepMutex);
+        }
+        for (size_t i = 1; i < slots.size(); i++)
+            SDL_WaitThread(slots[i]->thread, nullptr);
+
+        // Jobs still running during the first loop may have queued more, e.g. into the slot of a
+        // worker that had already stopped. Nothing else can queue now, so this empties every queue.
+        while (PopMain(task) || Pop(0, task) || Steal(0, task))
+            Execute(task, 0);
+
+        SDL_DestroyCondition(wake);
+        SDL_DestroyMutex(sleepMutex);
+    }
+
+    void Scheduler::Run(Job job, Counter *counter, const char *name)
+    {
+        if (counter)
+            SDL_AddAtomicInt(&counter->pending, 1);
+        Push({std::move(job), counter, name});
+    }
+
+    void Scheduler::RunAfter(Counter &dependency, Job job, Counter *counter, const char *name)
+    {
+        if (counter)
+            SDL_AddAtomicInt(&counter->pending, 1);
+
+        SDL_LockSpinlock(&dependency.lock);
+        if (SDL_GetAtomicInt(&dependency.pending) != 0)
+        {
+            dependency.continuations.push_back({std::move(job), counter, name});
+            SDL_UnlockSpinlock(&dependency.lock);
+            return;
+        }
+        SDL_UnlockSpinlock(&dependency.lock);
+        Push({std::move(job), counter, name});
+    }
+
+    void Scheduler::RunOnMainThread(Job job, Counter *counter, const char *name)
+    {
+        if (counter)
+            SDL_AddAtomicInt(&counter->pending, 1);
+
+        SDL_LockSpinlock(&mainLock);
+        mainTasks.push_back({std::move(job), counter, name});
+        SDL_UnlockSpinlock(&mainLock);
+        SDL_AddAtomicInt(&mainQueued, 1);
+        WakeAll();
+    }
+
+    void Scheduler::PumpMainThread()
+    {
+        // Only what is queued now: a job that queues another main-thread job doesn't keep the frame here.
+        for (int count = SDL_GetAtomicInt(&mainQueued); count > 0; count--)
+        {
+            Task task;
+            if (!PopMain(task))
+                break;
+            Execute(task, 0);
+        }
+    }
+
+    void Scheduler::Wait(Counter &counter)
+    {
+        const int slot = CurrentSlot();
+        const bool main = slot == 0;
+        while (!counter.IsDone())
+        {
+            Task task;
+            if ((main && PopMain(task)) || (slot >= 0 && Pop(slot, task)) || Steal(slot, task))
+            {
+                Execute(task, std::max(slot, 0));
+                continue;
+            }
+
+            // Nothing to help with: sleep until a job is queued or a counter drops to zero.
+            SDL_LockMutex(sleepMutex);
+            SDL_AddAtomicInt(&sleeping, 1);
+            while (!counter.IsDone() && SDL_GetAtomicInt(&queued) == 0 && !(main && SDL_GetAtomicInt(&mainQueued) > 0))
+                SDL_WaitCondition(wake, sleepMutex);
+            SDL_AddAtomicInt(&sleeping, -1);
+            SDL_UnlockMutex(sleepMutex);
+        }
+    }
+
+    Scheduler::Stats Scheduler::GetStats() const
+    {
+        Stats stats;
+        for (const std::unique_ptr<Slot> &slot : slots)
+        {
+            stats.executed += static_cast<Uint32>(SDL_GetAtomicInt(&slot->executed));
+            stats.stolen += static_cast<Uint32>(SDL_GetAtomicInt(&slot->stolen));
+        }
+        return stats;
+    }
+
+    int Scheduler::CurrentSlot() const
+    {
+        if (currentScheduler == this)
+            return currentSlot;
+        return IsMainThread() ? 0 : -1;
+    }
+
+    void Scheduler::Push(Task task)
+    {
+        int slot = CurrentSlot();
+        if (slots.size() == 1)
+            slot = 0;
+        else if (slot < 0)
+            slot = static_cast<int>(static_cast<Uint32>(SDL_AddAtomicInt(&nextSlot, 1)) % (slots.size() - 1)) + 1;
+
+        Slot &target = *slots[slot];
+        SDL_LockSpinlock(&target.lock);
+        target.tasks.push_back(std::move(task));
+        SDL_UnlockSpinlock(&target.lock);
+        SDL_AddAtomicInt(&queued, 1);
+        WakeAll();
+    }
+
+    bool Scheduler::Pop(int slot, Task &task)
+    {
+        Slot &own = *slots[slot];
+        SDL_LockSpinlock(&own.lock);
+        const bool found = !own.tasks.empty();
+        if (found)
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+        SDL_UnlockSpinlock(&own.lock);
+        if (found)
+            SDL_AddAtomicInt(&queued, -1);
+        return found;
+    }
+
+    bool Scheduler::Steal(int thief, Task &task)
+    {
+        if (SDL_GetAtomicInt(&queued) == 0)
+            return false;
+
+        // Start after the thief, so that the victims differ between threads.
+        const int count = static_cast<int>(slots.size());
+        for (int i = 1; i <= count; i++)
+        {
+            const int victim = (std::max(thief, 0) + i) % count;
+            if (victim == thief)
+                continue;
+            Slot &slot = *slots[victim];
+            SDL_LockSpinlock(&slot.lock);
+            const bool found = !slot.tasks.empty();
+            if (found)
+            {
+                task = std::move(slot.tasks.front());
+                slot.tasks.pop_front();
+            }
+            SDL_UnlockSpinlock(&slot.lock);
+            if (found)
+            {
+                SDL_AddAtomicInt(&queued, -1);
+                SDL_AddAtomicInt(&slots[std::max(thief, 0)]->stolen, 1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool Scheduler::PopMain(Task &task)
+    {
+        if (SDL_GetAtomicInt(&mainQueued) == 0)
+            return false;
+
+        SDL_LockSpinlock(&mainLock);
+        const bool found = !mainTasks.empty();
+        if (found)
+        {
+            task = std::move(mainTasks.front());
+            mainTasks.pop_front();
+        }
+        SDL_UnlockSpinlock(&mainLock);
+        if (found)
+            SDL_AddAtomicInt(&mainQueued, -1);
+        return found;
+    }
+
+    void Scheduler::Execute(Task &task, int slot)
+    {
+        const TraceHook hook = traceHook;
+        const Uint64 start = hook ? SDL_GetTicksNS() : 0;
+        task.job();
+        if (hook)
+            hook(task.name, slot, start, SDL_GetTicksNS());
+
+        SDL_AddAtomicInt(&slots[slot]->executed, 1);
+        if (task.counter)
+            Finish(*task.counter);
+    }
+
+    void Scheduler::Finish(Counter &counter)
+    {
+        std::vector<Counter::Continuation> ready;
+        SDL_LockSpinlock(&counter.lock);
+        if (SDL_AddAtomicInt(&counter.pending, -1) == 1)
+            ready.swap(counter.continuations);
+        SDL_UnlockSpinlock(&counter.lock);
+
+        for (Counter::Continuation &continuation : ready)
+            Push({std::move(continuation.job), continuation.counter, continuation.name});
+        // Waiters check the counter itself.
+        WakeAll();
+    }
+
+    void Scheduler::WakeAll()
+    {
+        // Sleepers register before checking their conditions, so either they see the change or this sees them.
+        if (SDL_GetAtomicInt(&sleeping) == 0)
+            return;
+        SDL_LockMutex(sleepMutex);
+        SDL_BroadcastCondition(wake);
+        SDL_UnlockMutex(sleepMutex);
+    }
+
+    int SDLCALL Scheduler::WorkerMain(void *userdata)
+    {
+        const WorkerStart &start = *static_cast<WorkerStart *>(userdata);
+        start.scheduler->RunWorker(start.slot);
+        return 0;
+    }
+
+    void Scheduler::RunWorker(int slot)
+    {
+        core::memory::tracking::SetThreadName("jobs");
+        currentScheduler = this;
+        currentSlot = slot;
+
+        for (;;)
+        {
+            Task task;
+            if (Pop(slot, task) || Steal(slot, task))
+            {
+                Execute(task, slot);
+                continue;
+            }
+
+            SDL_LockMutex(sleepMutex);
+            SDL_AddAtomicInt(&sleeping, 1);
+            while (!quit && SDL_GetAtomicInt(&queued) == 0)
+                SDL_WaitCondition(wake, sleepMutex);
+            SDL_AddAtomicInt(&sleeping, -1);
+            const bool done = quit && SDL_GetAtomicInt(&queued) == 0;
+            SDL_UnlockMutex(sleepMutex);
+            if (done)
+                break;
+        }
+        currentScheduler = nullptr;
+        currentSlot = -1;
+    }
+
+} // namespace core::jobs
@@ -0,0 +1,211 @@
+#ifndef CORE_JOBS_SCHEDULER_H
+#define CORE_JOBS_SCHEDULER_H
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace core::jobs
+{
+
+    using Job = std::move_only_function<void()>;
+
+    class Scheduler;
+
+    /**
+     * @brief Number of unfinished jobs started with it. Scheduler::Wait() blocks on it and
+     * Scheduler::RunAfter() uses it as a dependency.
+     *
+     * Start every job of a group before waiting on or depending on its counter: a counter that
+     * has dropped to zero counts as done, even if more jobs are added afterwards.
+     */
+    class Counter
+    {
+    public:
+        Counter() = default;
+
+        /// Non-copyable: queued jobs point at it. Must outlive them.
+        Counter(const Counter &) = delete;
+        Counter &operator=(const Counter &) = delete;
+
+        bool IsDone()
+        {
+            // Under the lock: the last job releases it after its final access, so a done counter can be destroyed.
+            SDL_LockSpinlock(&lock);
+            const bool done = SDL_GetAtomicInt(&pending) == 0;
+            SDL_UnlockSpinlock(&lock);
+            return done;
+        }
+
+    private:
+        friend class Scheduler;
+
+        struct Continuation
+        {
+            Job job;
+            Counter *counter;
+            const char *name;
+        };
+
+        SDL_AtomicInt pending{};
+        SDL_SpinLock lock = 0; ///< Guards `continuations` and the drop to zero.
+        std::vector<Continuation> continuations;
+    };
+
+    /**
+     * @brief Work-stealing job scheduler.
+     *
+     * Each worker thread has its own deque: it pushes and pops the jobs it starts at the back, and
+     * idle workers steal from the front of the others, oldest first. The thread that created the
+     * scheduler (the main thread) has a deque too, which it only works through while it waits.
+     * Other threads hand their jobs to the workers in turn.
+     *
+     * Jobs that need the main thread, i.e. most SDL video and renderer calls, go through
+     * RunOnMainThread() and run in PumpMainThread() or while the main thread waits.
+     */
+    class Scheduler
+    {
+    public:
+        /// Called around every job when set. `name` is nullptr for unnamed jobs; `worker` is 0 on the main thread.
+        using TraceHook = void (*)(const char *name, int worker, Uint64 startNS, Uint64 endNS);
+
+        struct Stats
+        {
+            Uint64 executed{0};
+            Uint64 stolen{0}; ///< Jobs run by another thread than the one that queued them.
+        };
+
+        /**
+         * @param workerCount Threads started besides the main thread; negative picks one per additional logical core.
+         * Must be created on the main thread.
+         */
+        explicit Scheduler(int workerCount = -1);
+        ~Scheduler();
+
+        /// Non-copyable
+        Scheduler(const Scheduler &) = delete;
+        Scheduler &operator=(const Scheduler &) = delete;
+
+        /**
+         * @brief Queues a job on any thread.
+         * @param counter Incremented now and decremented when the job has run; may be null.
+         * @param name Shown by the trace hook; must be a literal or otherwise outlive the job.
+         */
+        void Run(Job job, Counter *counter = nullptr, const char *name = nullptr);
+
+        /**
+         * @brief Like Run(), once `dependency` is done. `counter` is incremented right away.
+         */
+        void RunAfter(Counter &dependency, Job job, Counter *counter = nullptr, const char *name = nullptr);
+
+        /**
+         * @brief Queues a job for the main thread, from any thread.
+         */
+        void RunOnMainThread(Job job, Counter *counter = nullptr, const char *name = nullptr);
+
+        /**
+         * @brief Runs the queued main-thread jobs. Once per frame, on the main thread.
+         */
+        void PumpMainThread();
+
+        /**
+         * @brief Returns once `counter` is done, running other jobs in the meantime. On the main thread
+         * that includes the main-thread jobs, so waiting on one of them doesn't deadlock.
+         */
+        void Wait(Counter &counter);
+
+        /**
+         * @brief Calls `body(first, last)` for consecutive slices of [begin, end) of at most `grain`
+         * items, spread over the workers and the calling thread. Returns when every slice is done.
+         */
+        template <typename Body>
+        void ParallelFor(size_t begin, size_t end, size_t grain, Body &&body)
+        {
+            grain = std::max<size_t>(grain, 1);
+            if (end <= begin)
+                return;
+            if (end - begin <= grain || workers.empty())
+            {
+                body(begin, end);
+                return;
+            }
+
+            // Queued back to front: the caller pops the first slices itself, thieves take the last ones.
+            Counter counter;
+            const size_t first = begin + grain;
+            for (size_t slice = first + (end - first - 1) / grain * grain; slice >= first; slice -= grain)
+            {
+                Run([&body, slice, last = std::min(slice + grain, end)]
+                    { body(slice, last); },
+                    &counter);
+            }
+            body(begin, first);
+            Wait(counter);
+        }
+
+        /// Threads started besides the main thread.
+        int GetWorkerCount() const { return static_cast<int>(workers.size()); }
+        bool IsMainThread() const { return SDL_GetCurrentThreadID() == mainThread; }
+        Stats GetStats() const;
+
+        void SetTraceHook(TraceHook hook) { traceHook = hook; }
+
+    private:
+        struct Task
+        {
+            Job job;
+            Counter *counter;
+            const char *name;
+        };
+
+        /// Slot 0 is the main thread, the others are the worker threads.
+        struct Slot
+        {
+            SDL_SpinLock lock = 0;
+            std::deque<Task> tasks;
+            SDL_Thread *thread{nullptr};
+            SDL_AtomicInt executed{};
+            SDL_AtomicInt stolen{};
+        };
+
+        struct WorkerStart
+        {
+            Scheduler *scheduler;
+            int slot;
+        };
+
+        std::vector<std::unique_ptr<Slot>> slots;
+        std::vector<WorkerStart> workers;
+        SDL_ThreadID mainThread;
+        TraceHook traceHook{nullptr};
+
+        SDL_SpinLock mainLock = 0;
+        std::deque<Task> mainTasks;
+
+        SDL_AtomicInt queued{};     ///< Tasks in the slots, for the sleeping threads.
+        SDL_AtomicInt mainQueued{}; ///< Tasks in `mainTasks`.
+        SDL_AtomicInt sleeping{};
+        SDL_AtomicInt nextSlot{};   ///< Round robin for jobs queued by other threads.
+        SDL_Mutex *sleepMutex{nullptr};
+        SDL_Condition *wake{nullptr};
+        bool quit{false};
+
+        int CurrentSlot() const;
+        void Push(Task task);
+        bool Pop(int slot, Task &task);
+        bool Steal(int thief, Task &task);
+        bool PopMain(Task &task);
+        void Execute(Task &task, int slot);
+        void Finish(Counter &counter);
+        void WakeAll();
+
+        static int SDLCALL WorkerMain(void *userdata);
+        void RunWorker(int slot);
+    };
+
+} // namespace core::jobs
+
+#endif // CORE_JOBS_SCHEDULER_H
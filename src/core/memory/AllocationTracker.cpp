@@ -0,0 +1,352 @@
+#include "core/memory/AllocationTracker.h"
+
+#include <SDL3/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace core::memory::tracking
+{
+
+    static constexpr size_t PHASES = static_cast<size_t>(Phase::COUNT);
+    /// Minimum time between two over-budget warnings.
+    static constexpr Uint64 WARNING_INTERVAL_MS = 1000;
+
+    /// Counters written by a single thread; padded so threads do not share cache lines.
+    struct alignas(64) Slot
+    {
+        std::atomic<Uint64> allocations[PHASES];
+        std::atomic<Uint64> frees[PHASES];
+        std::atomic<Uint64> bytes[PHASES];
+        std::atomic<const char *> name;
+    };
+
+    static Slot slots[MAX_THREADS];
+    static std::atomic<int> slotsUsed{0};
+
+    static thread_local int threadSlot = -1;
+    static thread_local Phase threadPhase = Phase::OTHER;
+
+    // Main thread only, touched by EndFrame()
+    static Counters previous[MAX_THREADS][PHASES];
+    static FrameReport lastFrame;
+    static std::array<Uint64, PHASES> budgets = []
+    {
+        std::array<Uint64, PHASES> all{};
+        all.fill(UNLIMITED);
+        return all;
+    }();
+    static Uint64 overBudgetFrames = 0;
+    static Uint64 lastWarningTicks = 0;
+
+    // Called from inside the allocator: must not allocate.
+    static Slot &CurrentSlot()
+    {
+        if (threadSlot < 0)
+        {
+            threadSlot = SDL_min(slotsUsed.fetch_add(1, std::memory_order_relaxed), MAX_THREADS - 1);
+        }
+        return slots[threadSlot];
+    }
+
+    [[maybe_unused]] static void RecordAllocation(size_t size)
+    {
+        Slot &slot = CurrentSlot();
+        const size_t phase = static_cast<size_t>(threadPhase);
+        slot.allocations[phase].fetch_add(1, std::memory_order_relaxed);
+        slot.bytes[phase].fetch_add(size, std::memory_order_relaxed);
+    }
+
+    [[maybe_unused]] static void RecordFree()
+    {
+        Slot &slot = CurrentSlot();
+        slot.frees[static_cast<size_t>(threadPhase)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static Counters Read(const Slot &slot, size_t phase)
+    {
+        return {slot.allocations[phase].load(std::memory_order_relaxed),
+                slot.frees[phase].load(std::memory_order_relaxed),
+                slot.bytes[phase].load(std::memory_order_relaxed)};
+    }
+
+#ifdef CORE_TRACK_ALLOCATIONS
+    static SDL_malloc_func originalMalloc = nullptr;
+    static SDL_calloc_func originalCalloc = nullptr;
+    static SDL_realloc_func originalRealloc = nullptr;
+    static SDL_free_func originalFree = nullptr;
+
+    static void *SDLCALL TrackedMalloc(size_t size)
+    {
+        RecordAllocation(size);
+        return originalMalloc(size);
+    }
+
+    static void *SDLCALL TrackedCalloc(size_t count, size_t size)
+    {
+        RecordAllocation(count * size);
+        return originalCalloc(count, size);
+    }
+
+    static void *SDLCALL TrackedRealloc(void *memory, size_t size)
+    {
+        // A resize counts as a new allocation replacing the old one.
+        if (memory)
+            RecordFree();
+        RecordAllocation(size);
+        return originalRealloc(memory, size);
+    }
+
+    static void SDLCALL TrackedFree(void *memory)
+    {
+        if (memory)
+            RecordFree();
+        originalFree(memory);
+    }
+#endif
+
+    bool InstallSDLHooks()
+    {
+#ifdef CORE_TRACK_ALLOCATIONS
+        SDL_GetOriginalMemoryFunctions(&originalMalloc, &originalCalloc, &originalRealloc, &originalFree);
+        return SDL_SetMemoryFunctions(TrackedMalloc, TrackedCalloc, TrackedRealloc, TrackedFree);
+#else
+        return false;
+#endif
+    }
+
+    const char *GetPhaseName(Phase phase)
+    {
+        switch (phase)
+        {
+        case Phase::OTHER:
+            return "other";
+        case Phase::EVENTS:
+            return "events";
+        case Phase::UPDATE:
+            return "update";
+        case Phase::RENDER:
+            return "render";
+        case Phase::OVERLAY:
+            return "overlay";
+        case Phase::PRESENT:
+            return "present";
+        case Phase::SCENE_CHANGE:
+            return "scene change";
+        case Phase::DOCUMENT_LOAD:
+            return "document load";
+        case Phase::RELEASE:
+            return "release";
+        default:
+            return "?";
+        }
+    }
+
+    void SetThreadName(const char *name)
+    {
+        CurrentSlot().name.store(name, std::memory_order_relaxed);
+    }
+
+    const char *GetThreadName(int slot)
+    {
+        if (slot < 0 || slot >= MAX_THREADS)
+            return nullptr;
+        return slots[slot].name.load(std::memory_order_relaxed);
+    }
+
+    Counters GetThreadCounters()
+    {
+        const Slot &slot = CurrentSlot();
+        Counters total;
+        for (size_t phase = 0; phase < PHASES; phase++)
+        {
+            total += Read(slot, phase);
+        }
+        return total;
+    }
+
+    void EndFrame()
+    {
+        FrameReport report;
+        report.frame = lastFrame.frame + 1;
+        report.threadCount = SDL_min(slotsUsed.load(std::memory_order_relaxed), MAX_THREADS);
+
+        for (int thread = 0; thread < report.threadCount; thread++)
+        {
+            for (size_t phase = 0; phase < PHASES; phase++)
+            {
+                const Counters now = Read(slots[thread], phase);
+                Counters &before = previous[thread][phase];
+                const Counters delta{now.allocations - before.allocations, now.frees - before.frees, now.bytes - before.bytes};
+                before = now;
+
+                report.phases[phase] += delta;
+                report.threads[thread] += delta;
+                report.total += delta;
+            }
+        }
+        lastFrame = report;
+
+        bool overBudget = false;
+        for (size_t phase = 0; phase < PHASES; phase++)
+        {
+            if (report.phases[phase].allocations <= budgets[phase])
+                continue;
+
+            overBudget = true;
+            const Uint64 now = SDL_GetTicks();
+            if (now - lastWarningTicks >= WARNING_INTERVAL_MS)
+            {
+                lastWarningTicks = now;
+                SDL_LogWarn(SDL_LOG_CATEGORY_SYSTEM, "Frame %llu: %s made %llu allocations (budget %llu)",
+                            static_cast<unsigned long long>(report.frame), GetPhaseName(static_cast<Phase>(phase)),
+                            static_cast<unsigned long long>(report.phases[phase].allocations),
+                            static_cast<unsigned long long>(budgets[phase]));
+            }
+        }
+        if (overBudget)
+        {
+            overBudgetFrames++;
+        }
+    }
+
+    const FrameReport &GetLastFrame()
+    {
+        return lastFrame;
+    }
+
+    void SetFrameBudget(Phase phase, Uint64 maxAllocations)
+    {
+        budgets[static_cast<size_t>(phase)] = maxAllocations;
+    }
+
+    Uint64 GetOverBudgetFrames()
+    {
+        return overBudgetFrames;
+    }
+
+    PhaseScope::PhaseScope(Phase phase) : previous(threadPhase)
+    {
+        threadPhase = phase;
+    }
+
+    PhaseScope::~PhaseScope()
+    {
+        threadPhase = previous;
+    }
+
+} // namespace core::memory::tracking
+
+#ifdef CORE_TRACK_ALLOCATIONS
+
+// Global allocation functions. They use the C heap directly: going through SDL_malloc
+// would count every allocation twice once the SDL hooks are installed.
+
+namespace
+{
+    void *AllocateOrThrow(std::size_t size)
+    {
+        for (;;)
+        {
+            if (void *memory = std::malloc(size ? size : 1))
+                return memory;
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    // Over-allocates and keeps the original pointer right before the aligned block,
+    // so the matching delete works the same on every platform.
+    void *AllocateAligned(std::size_t size, std::size_t alignment)
+    {
+        void *raw = std::malloc(size + alignment + sizeof(void *));
+        if (!raw)
+            return nullptr;
+        const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void *);
+        void *aligned = reinterpret_cast<void *>((start + alignment - 1) & ~(std::uintptr_t(alignment) - 1));
+        static_cast<void **>(aligned)[-1] = raw;
+        return aligned;
+    }
+
+    void FreeAligned(void *memory)
+    {
+        if (memory)
+            std::free(static_cast<void **>(memory)[-1]);
+    }
+
+    void *TrackedNew(std::size_t size)
+    {
+        core::memory::tracking::RecordAllocation(size);
+        return AllocateOrThrow(size);
+    }
+
+    void *TrackedNew(std::size_t size, std::align_val_t alignment)
+    {
+        core::memory::tracking::RecordAllocation(size);
+        for (;;)
+        {
+            if (void *memory = AllocateAligned(size, static_cast<std::size_t>(alignment)))
+                return memory;
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    void TrackedDelete(void *memory)
+    {
+        if (!memory)
+            return;
+        core::memory::tracking::RecordFree();
+        std::free(memory);
+    }
+
+    void TrackedDeleteAligned(void *memory)
+    {
+        if (!memory)
+            return;
+        core::memory::tracking::RecordFree();
+        FreeAligned(memory);
+    }
+} // namespace
+
+void *operator new(std::size_t size) { return TrackedNew(size); }
+void *operator new[](std::size_t size) { return TrackedNew(size); }
+void *operator new(std::size_t size, std::align_val_t alignment) { return TrackedNew(size, alignment); }
+void *operator new[](std::size_t size, std::align_val_t alignment) { return TrackedNew(size, alignment); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    try { return TrackedNew(size); } catch (...) { return nullptr; }
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    try { return TrackedNew(size); } catch (...) { return nullptr; }
+}
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    try { return TrackedNew(size, alignment); } catch (...) { return nullptr; }
+}
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    try { return TrackedNew(size, alignment); } catch (...) { return nullptr; }
+}
+
+void operator delete(void *memory) noexcept { TrackedDelete(memory); }
+void operator delete[](void *memory) noexcept { TrackedDelete(memory); }
+void operator delete(void *memory, std::size_t) noexcept { TrackedDelete(memory); }
+void operator delete[](void *memory, std::size_t) noexcept { TrackedDelete(memory); }
+void operator delete(void *memory, const std::nothrow_t &) noexcept { TrackedDelete(memory); }
+void operator delete[](void *memory, const std::nothrow_t &) noexcept { TrackedDelete(memory); }
+void operator delete(void *memory, std::align_val_t) noexcept { TrackedDeleteAligned(memory); }
+void operator delete[](void *memory, std::align_val_t) noexcept { TrackedDeleteAligned(memory); }
+void operator delete(void *memory, std::size_t, std::align_val_t) noexcept { TrackedDeleteAligned(memory); }
+void operator delete[](void *memory, std::size_t, std::align_val_t) noexcept { TrackedDeleteAligned(memory); }
+void operator delete(void *memory, std::align_val_t, const std::nothrow_t &) noexcept { TrackedDeleteAligned(memory); }
+void operator delete[](void *memory, std::align_val_t, const std::nothrow_t &) noexcept { TrackedDeleteAligned(memory); }
+
+#endif // CORE_TRACK_ALLOCATIONS
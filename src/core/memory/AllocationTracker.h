@@ -0,0 +1,152 @@
+#ifndef CORE_MEMORY_ALLOCATION_TRACKER_H
+#define CORE_MEMORY_ALLOCATION_TRACKER_H
+
+#include <SDL3/SDL.h>
+#include <array>
+
+namespace core::memory::tracking
+{
+
+    /**
+     * @brief Part of the frame an allocation is attributed to.
+     * Each thread has its own current phase, set with PhaseScope. Threads that never set one
+     * report everything under OTHER.
+     */
+    enum class Phase
+    {
+        OTHER,
+        EVENTS,
+        UPDATE,
+        RENDER,
+        OVERLAY,
+        PRESENT,
+        SCENE_CHANGE,
+        DOCUMENT_LOAD,
+        RELEASE,
+        COUNT
+    };
+
+    /// Threads beyond this number share the last slot.
+    inline constexpr int MAX_THREADS = 16;
+
+    struct Counters
+    {
+        Uint64 allocations{0}; ///< Calls to operator new, SDL_malloc, SDL_calloc and SDL_realloc.
+        Uint64 frees{0};       ///< Calls releasing a non-null pointer.
+        Uint64 bytes{0};       ///< Bytes requested by those allocations.
+
+        Counters &operator+=(const Counters &other)
+        {
+            allocations += other.allocations;
+            frees += other.frees;
+            bytes += other.bytes;
+            return *this;
+        }
+    };
+
+    /// Allocations made between two EndFrame() calls.
+    struct FrameReport
+    {
+        Uint64 frame{0};
+        Counters total;
+        std::array<Counters, static_cast<size_t>(Phase::COUNT)> phases{};
+        std::array<Counters, MAX_THREADS> threads{}; ///< Indexed by thread slot, see GetThreadName().
+        int threadCount{0};                          ///< Number of slots in use.
+    };
+
+    /**
+     * @brief True when built with CORE_TRACK_ALLOCATIONS (CMake option TRACK_ALLOCATIONS).
+     * Otherwise nothing is hooked and every counter stays at zero.
+     */
+    constexpr bool IsEnabled()
+    {
+#ifdef CORE_TRACK_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Routes SDL's allocator through the tracker.
+     * Call it before any other SDL function. Memory SDL allocated earlier is still released correctly.
+     * @return false if tracking is disabled or SDL rejected the functions.
+     */
+    bool InstallSDLHooks();
+
+    const char *GetPhaseName(Phase phase);
+
+    /**
+     * @brief Names the calling thread in reports. The string must outlive the program.
+     */
+    void SetThreadName(const char *name);
+
+    /// Name of a thread slot, or nullptr if the thread never named itself.
+    const char *GetThreadName(int slot);
+
+    /// Everything the calling thread allocated since startup.
+    Counters GetThreadCounters();
+
+    /**
+     * @brief Closes the current frame: computes its report and checks the budgets.
+     * Call it once per frame from the main thread.
+     */
+    void EndFrame();
+
+    /// Report of the last frame closed by EndFrame().
+    const FrameReport &GetLastFrame();
+
+    /**
+     * @brief Maximum allocations a phase may make in one frame, summed over all threads.
+     * Frames over budget are counted and logged at most once per second.
+     * @param maxAllocations Limit, or UNLIMITED to remove it.
+     */
+    void SetFrameBudget(Phase phase, Uint64 maxAllocations);
+    inline constexpr Uint64 UNLIMITED = ~Uint64{0};
+
+    /// Number of frames in which any phase exceeded its budget.
+    Uint64 GetOverBudgetFrames();
+
+    /**
+     * @brief Attributes the allocations of the calling thread to a phase until destroyed.
+     */
+    class PhaseScope
+    {
+    public:
+        explicit PhaseScope(Phase phase);
+        ~PhaseScope();
+
+        PhaseScope(const PhaseScope &) = delete;
+        PhaseScope &operator=(const PhaseScope &) = delete;
+
+    private:
+        Phase previous;
+    };
+
+    /**
+     * @brief Counts what the calling thread allocates during its lifetime.
+     * Meant for checks such as "a game frame allocates nothing":
+     * @code
+     * core::memory::tracking::Scope scope;
+     * scene.Update(dt);
+     * SDL_assert(scope.Get().allocations == 0);
+     * @endcode
+     */
+    class Scope
+    {
+    public:
+        Scope() : start(GetThreadCounters()) {}
+
+        Counters Get() const
+        {
+            const Counters now = GetThreadCounters();
+            return {now.allocations - start.allocations, now.frees - start.frees, now.bytes - start.bytes};
+        }
+
+    private:
+        Counters start;
+    };
+
+} // namespace core::memory::tracking
+
+#endif // CORE_MEMORY_ALLOCATION_TRACKER_H
@@ -0,0 +1,57 @@
+#include "core/memory/DeferredRelease.h"
+
+#include <utility>
+
+namespace core::memory
+{
+
+    DeferredReleaseQueue::~DeferredReleaseQueue()
+    {
+        Flush();
+    }
+
+    void DeferredReleaseQueue::Push(Release release, Ready ready)
+    {
+        entries.push_back({std::move(release), std::move(ready)});
+    }
+
+    void DeferredReleaseQueue::Run(Uint64 budgetNS)
+    {
+        const Uint64 start = SDL_GetTicksNS();
+
+        // Only what was queued before this call: postponed entries go back to the end and must not be seen twice.
+        size_t remaining = entries.size();
+        bool ranOne = false;
+        while (remaining > 0 && (!ranOne || SDL_GetTicksNS() - start < budgetNS))
+        {
+            Entry entry = std::move(entries.front());
+            entries.pop_front();
+            remaining--;
+
+            if (entry.ready && !entry.ready())
+            {
+                entries.push_back(std::move(entry));
+                stats.postponed++;
+                continue;
+            }
+
+            entry.release();
+            stats.released++;
+            ranOne = true;
+        }
+        stats.lastRunNS = SDL_GetTicksNS() - start;
+    }
+
+    void DeferredReleaseQueue::Flush()
+    {
+        // Releases may queue further releases, which are flushed too.
+        while (!entries.empty())
+        {
+            Entry entry = std::move(entries.front());
+            entries.pop_front();
+            entry.release();
+            stats.released++;
+        }
+    }
+
+} // namespace core::memory
@@ -0,0 +1,73 @@
+#ifndef CORE_MEMORY_DEFERRED_RELEASE_H
+#define CORE_MEMORY_DEFERRED_RELEASE_H
+
+#include <SDL3/SDL.h>
+#include <deque>
+#include <functional>
+
+namespace core::memory
+{
+
+    /**
+     * @brief Releases resources at the end of frames, a few at a time, instead of where they are dropped.
+     *
+     * Tearing a scene down inside an event callback frees everything in one go and shows up as a
+     * frame spike. Code that drops resources pushes the release here instead; Run() executes the
+     * queue in order at the end of each frame and stops once its time budget is spent, leaving the
+     * rest for the following frames.
+     *
+     * A release can come with a `ready` check, e.g. "the sound has stopped playing"; while it
+     * returns false the release is postponed to a later frame, and Flush() ignores it.
+     *
+     * Not thread-safe: push and run from the main thread. Releases may push more releases.
+     */
+    class DeferredReleaseQueue
+    {
+    public:
+        using Release = std::move_only_function<void()>;
+        using Ready = std::move_only_function<bool()>;
+
+        struct Stats
+        {
+            Uint64 released{0};
+            Uint64 postponed{0}; ///< Times a release wasn't ready yet.
+            Uint64 lastRunNS{0}; ///< Duration of the last Run().
+        };
+
+        DeferredReleaseQueue() = default;
+        ~DeferredReleaseQueue();
+
+        /// Non-copyable
+        DeferredReleaseQueue(const DeferredReleaseQueue &) = delete;
+        DeferredReleaseQueue &operator=(const DeferredReleaseQueue &) = delete;
+
+        void Push(Release release, Ready ready = {});
+
+        /**
+         * @brief Runs queued releases until `budgetNS` has elapsed. At least one release runs per call,
+         * so the queue drains even when a single release is over budget.
+         */
+        void Run(Uint64 budgetNS);
+
+        /**
+         * @brief Runs every release now, ready or not. For shutdown, before the owners of the resources go away.
+         */
+        void Flush();
+
+        size_t GetPending() const { return entries.size(); }
+        const Stats &GetStats() const { return stats; }
+
+    private:
+        struct Entry
+        {
+            Release release;
+            Ready ready;
+        };
+
+        std::deque<Entry> entries;
+        Stats stats;
+    };
+
+} // namespace core::memory
+
+#endif // CORE_MEMORY_DEFERRED_RELEASE_H
@@ -0,0 +1,77 @@
+#include "core/memory/FrameArena.h"
+
+#include <SDL3/SDL.h>
+
+namespace core::memory
+{
+
+    static size_t AlignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    FrameArena::FrameArena(size_t capacity) : capacity(capacity)
+    {
+        block = static_cast<std::byte *>(SDL_aligned_alloc(alignof(std::max_align_t), capacity));
+        if (!block)
+        {
+            // Every allocation will overflow to the heap until the next Reset() manages to grow.
+            SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Failed to allocate %zu byte frame arena", capacity);
+            this->capacity = 0;
+        }
+    }
+
+    FrameArena::~FrameArena()
+    {
+        Reset();
+        SDL_aligned_free(block);
+    }
+
+    void *FrameArena::Allocate(size_t size, size_t alignment)
+    {
+        // The block itself is aligned to max_align_t, so offsets only need the requested alignment.
+        const size_t offset = AlignUp(used, alignment);
+        if (offset + size <= capacity)
+        {
+            used = offset + size;
+            return block + offset;
+        }
+
+        // Out of space: serve this frame from the heap and remember to grow.
+        void *memory = SDL_aligned_alloc(SDL_max(alignment, alignof(std::max_align_t)), size ? size : 1);
+        if (!memory)
+            throw std::bad_alloc(); // Same contract as operator new, since containers allocate through here.
+        overflow.push_back(memory);
+        overflowBytes += size;
+        overflowCount++;
+        return memory;
+    }
+
+    void FrameArena::Reset()
+    {
+        const size_t frameTotal = used + overflowBytes;
+        peak = SDL_max(peak, frameTotal);
+
+        for (void *memory : overflow)
+            SDL_aligned_free(memory);
+        overflow.clear();
+
+        if (overflowBytes > 0)
+        {
+            // Grow once to the peak plus headroom so the next frames fit in the block.
+            const size_t grown = AlignUp(frameTotal + frameTotal / 2, 4096);
+            std::byte *larger = static_cast<std::byte *>(SDL_aligned_alloc(alignof(std::max_align_t), grown));
+            if (larger)
+            {
+                SDL_aligned_free(block);
+                block = larger;
+                capacity = grown;
+            }
+            SDL_LogDebug(SDL_LOG_CATEGORY_SYSTEM, "Frame arena grown to %zu bytes", capacity);
+        }
+
+        used = 0;
+        overflowBytes = 0;
+    }
+
+} // namespace core::memory
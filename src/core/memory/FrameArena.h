@@ -0,0 +1,105 @@
+#ifndef CORE_MEMORY_FRAME_ARENA_H
+#define CORE_MEMORY_FRAME_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace core::memory
+{
+
+    /**
+     * @brief Linear allocator for data that only lives until the end of the frame.
+     *
+     * Allocation bumps a pointer; nothing is freed individually. Reset() is called once at the
+     * end of SDL_AppIterate and makes the whole block available again. When a frame needs more
+     * than the block holds, the excess comes from temporary overflow blocks and the main block
+     * grows to the peak at the next Reset(), so steady-state frames never touch the heap.
+     *
+     * Not thread-safe: use it from the main thread only.
+     */
+    class FrameArena
+    {
+    public:
+        explicit FrameArena(size_t capacity = 256 * 1024);
+        ~FrameArena();
+
+        /// Non-copyable
+        FrameArena(const FrameArena &) = delete;
+        FrameArena &operator=(const FrameArena &) = delete;
+
+        /**
+         * @brief Returns uninitialized memory valid until the next Reset().
+         */
+        void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * @brief Returns storage for `count` objects of type T. The objects are not constructed.
+         */
+        template <typename T>
+        T *AllocateArray(size_t count)
+        {
+            return static_cast<T *>(Allocate(count * sizeof(T), alignof(T)));
+        }
+
+        /**
+         * @brief Releases everything allocated since the last reset.
+         */
+        void Reset();
+
+        size_t GetUsed() const { return used + overflowBytes; }
+        size_t GetCapacity() const { return capacity; }
+        size_t GetPeak() const { return peak; }
+        /// Number of heap allocations made for overflow since construction.
+        size_t GetOverflowCount() const { return overflowCount; }
+
+    private:
+        std::byte *block{nullptr};
+        size_t capacity{0};
+        size_t used{0};
+        size_t peak{0};
+        std::vector<void *> overflow;
+        size_t overflowBytes{0};
+        size_t overflowCount{0};
+    };
+
+    /**
+     * @brief Standard allocator that takes its memory from a FrameArena.
+     * Deallocation is a no-op; containers using it must not outlive the frame.
+     */
+    template <typename T>
+    class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+
+        explicit ArenaAllocator(FrameArena *arena) noexcept : arena(arena) {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U> &other) noexcept : arena(other.arena) {}
+
+        T *allocate(size_t count) { return arena->AllocateArray<T>(count); }
+        void deallocate(T *, size_t) noexcept {}
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U> &other) const noexcept { return arena == other.arena; }
+
+    private:
+        template <typename U>
+        friend class ArenaAllocator;
+
+        FrameArena *arena;
+    };
+
+    /// Scratch vector living in the frame arena.
+    template <typename T>
+    using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+    /// Scratch string living in the frame arena.
+    using FrameString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+} // namespace core::memory
+
+#endif // CORE_MEMORY_FRAME_ARENA_H
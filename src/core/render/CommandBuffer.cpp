@@ -0,0 +1,225 @@
+#include "core/render/CommandBuffer.h"
+
+#include <cstring>
+
+namespace core::render
+{
+
+    CommandBuffer::Command &CommandBuffer::Push(Type type)
+    {
+        Command &command = commands.emplace_back();
+        command.type = type;
+        return command;
+    }
+
+    void CommandBuffer::SetDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+    {
+        Command &command = Push(Type::SET_DRAW_COLOR);
+        command.color[0] = r;
+        command.color[1] = g;
+        command.color[2] = b;
+        command.color[3] = a;
+    }
+
+    void CommandBuffer::SetDrawBlendMode(SDL_BlendMode blendMode)
+    {
+        Push(Type::SET_DRAW_BLEND_MODE).blendMode = blendMode;
+    }
+
+    void CommandBuffer::Clear()
+    {
+        Push(Type::CLEAR);
+    }
+
+    void CommandBuffer::FillRect(const SDL_FRect *rect)
+    {
+        Command &command = Push(Type::FILL_RECT);
+        if (rect)
+        {
+            command.hasTarget = true;
+            command.target = *rect;
+        }
+    }
+
+    void CommandBuffer::Texture(SDL_Texture *texture, const SDL_FRect *source, const SDL_FRect *target)
+    {
+        Command &command = Push(Type::TEXTURE);
+        command.texture = texture;
+        if (source)
+        {
+            command.hasSource = true;
+            command.source = *source;
+        }
+        if (target)
+        {
+            command.hasTarget = true;
+            command.target = *target;
+        }
+    }
+
+    SDL_Vertex *CommandBuffer::Geometry(SDL_Texture *texture, int vertexCount, const int *indexData, int indexCount)
+    {
+        Command &command = Push(Type::GEOMETRY);
+        command.texture = texture;
+        command.first = static_cast<Uint32>(vertices.size());
+        command.count = static_cast<Uint32>(vertexCount);
+        command.firstIndex = static_cast<Uint32>(indices.size());
+        command.indexCount = indexData ? static_cast<Uint32>(indexCount) : 0;
+
+        if (command.indexCount > 0)
+        {
+            indices.insert(indices.end(), indexData, indexData + indexCount);
+        }
+        vertices.resize(vertices.size() + vertexCount);
+        return vertices.data() + command.first;
+    }
+
+    void CommandBuffer::SetClipRect(const SDL_Rect *rect)
+    {
+        Command &command = Push(Type::SET_CLIP_RECT);
+        if (rect)
+        {
+            command.hasTarget = true;
+            command.rect = *rect;
+        }
+    }
+
+    void CommandBuffer::SetViewport(const SDL_Rect *rect)
+    {
+        Command &command = Push(Type::SET_VIEWPORT);
+        if (rect)
+        {
+            command.hasTarget = true;
+            command.rect = *rect;
+        }
+    }
+
+    void CommandBuffer::DebugText(float x, float y, const char *string)
+    {
+        Command &command = Push(Type::DEBUG_TEXT);
+        command.target = {x, y, 0.0f, 0.0f};
+        command.first = static_cast<Uint32>(text.size());
+        text.insert(text.end(), string, string + std::strlen(string) + 1);
+    }
+
+    void CommandBuffer::DestroyTexture(SDL_Texture *texture)
+    {
+        if (texture)
+        {
+            Push(Type::DESTROY_TEXTURE).texture = texture;
+        }
+    }
+
+    void CommandBuffer::SetRenderTarget(SDL_Texture *texture)
+    {
+        Push(Type::SET_RENDER_TARGET).texture = texture;
+    }
+
+    void CommandBuffer::SetTextureBlendMode(SDL_Texture *texture, SDL_BlendMode blendMode)
+    {
+        Command &command = Push(Type::SET_TEXTURE_BLEND_MODE);
+        command.texture = texture;
+        command.blendMode = blendMode;
+    }
+
+    void CommandBuffer::SetTextureMod(SDL_Texture *texture, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+    {
+        Command &command = Push(Type::SET_TEXTURE_MOD);
+        command.texture = texture;
+        command.color[0] = r;
+        command.color[1] = g;
+        command.color[2] = b;
+        command.color[3] = a;
+    }
+
+    void CommandBuffer::Append(const CommandBuffer &other, SDL_Texture *baseTarget)
+    {
+        const Uint32 vertexBase = static_cast<Uint32>(vertices.size());
+        const Uint32 indexBase = static_cast<Uint32>(indices.size());
+        const Uint32 textBase = static_cast<Uint32>(text.size());
+
+        vertices.insert(vertices.end(), other.vertices.begin(), other.vertices.end());
+        indices.insert(indices.end(), other.indices.begin(), other.indices.end());
+        text.insert(text.end(), other.text.begin(), other.text.end());
+
+        for (Command command : other.commands)
+        {
+            if (command.type == Type::GEOMETRY)
+            {
+                command.first += vertexBase;
+                command.firstIndex += indexBase;
+            }
+            else if (command.type == Type::DEBUG_TEXT)
+            {
+                command.first += textBase;
+            }
+            else if (command.type == Type::SET_RENDER_TARGET && !command.texture)
+            {
+                command.texture = baseTarget;
+            }
+            commands.push_back(command);
+        }
+    }
+
+    void CommandBuffer::Replay(SDL_Renderer *renderer) const
+    {
+        for (const Command &command : commands)
+        {
+            switch (command.type)
+            {
+            case Type::SET_DRAW_COLOR:
+                SDL_SetRenderDrawColor(renderer, command.color[0], command.color[1], command.color[2], command.color[3]);
+                break;
+            case Type::SET_DRAW_BLEND_MODE:
+                SDL_SetRenderDrawBlendMode(renderer, command.blendMode);
+                break;
+            case Type::CLEAR:
+                SDL_RenderClear(renderer);
+                break;
+            case Type::FILL_RECT:
+                SDL_RenderFillRect(renderer, command.hasTarget ? &command.target : nullptr);
+                break;
+            case Type::TEXTURE:
+                SDL_RenderTexture(renderer, command.texture, command.hasSource ? &command.source : nullptr,
+                                  command.hasTarget ? &command.target : nullptr);
+                break;
+            case Type::GEOMETRY:
+                SDL_RenderGeometry(renderer, command.texture, vertices.data() + command.first, static_cast<int>(command.count),
+                                   command.indexCount ? indices.data() + command.firstIndex : nullptr,
+                                   static_cast<int>(command.indexCount));
+                break;
+            case Type::SET_CLIP_RECT:
+                SDL_SetRenderClipRect(renderer, command.hasTarget ? &command.rect : nullptr);
+                break;
+            case Type::SET_VIEWPORT:
+                SDL_SetRenderViewport(renderer, command.hasTarget ? &command.rect : nullptr);
+                break;
+            case Type::DEBUG_TEXT:
+                SDL_RenderDebugText(renderer, command.target.x, command.target.y, text.data() + command.first);
+                break;
+            case Type::DESTROY_TEXTURE:
+                SDL_DestroyTexture(command.texture);
+                break;
+            case Type::SET_RENDER_TARGET:
+                SDL_SetRenderTarget(renderer, command.texture);
+                break;
+            case Type::SET_TEXTURE_BLEND_MODE:
+                SDL_SetTextureBlendMode(command.texture, command.blendMode);
+                break;
+            case Type::SET_TEXTURE_MOD:
+                SDL_SetTextureColorMod(command.texture, command.color[0], command.color[1], command.color[2]);
+                SDL_SetTextureAlphaMod(command.texture, command.color[3]);
+                break;
+            }
+        }
+    }
+
+    void CommandBuffer::Reset()
+    {
+        commands.clear();
+        vertices.clear();
+        indices.clear();
+        text.clear();
+    }
+
+} // namespace core::render
@@ -0,0 +1,120 @@
+#ifndef CORE_RENDER_COMMAND_BUFFER_H
+#define CORE_RENDER_COMMAND_BUFFER_H
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+namespace core::render
+{
+
+    /**
+     * @brief Recorded list of SDL_Renderer calls, replayed later in order.
+     *
+     * Recording only copies data into buffers owned by the command buffer, so it never touches
+     * the renderer and can run while another buffer is being replayed. Clear() keeps the
+     * capacity: after the first few frames recording does not allocate.
+     *
+     * Textures referenced by recorded commands must stay alive until the buffer is replayed,
+     * which is why destroying a texture is a command too.
+     */
+    class CommandBuffer
+    {
+    public:
+        CommandBuffer() = default;
+
+        /// Non-copyable
+        CommandBuffer(const CommandBuffer &) = delete;
+        CommandBuffer &operator=(const CommandBuffer &) = delete;
+
+        void SetDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+        void SetDrawBlendMode(SDL_BlendMode blendMode);
+        void Clear();
+        void FillRect(const SDL_FRect *rect);
+        void Texture(SDL_Texture *texture, const SDL_FRect *source, const SDL_FRect *target);
+
+        /**
+         * @brief Records an SDL_RenderGeometry call and returns storage for its vertices.
+         * The caller fills `vertexCount` vertices through the returned pointer, which is only
+         * valid until the next command is recorded. Indices are copied.
+         */
+        SDL_Vertex *Geometry(SDL_Texture *texture, int vertexCount, const int *indices, int indexCount);
+
+        /// nullptr disables clipping.
+        void SetClipRect(const SDL_Rect *rect);
+        /// nullptr resets the viewport to the whole target.
+        void SetViewport(const SDL_Rect *rect);
+        void DebugText(float x, float y, const char *text);
+        void DestroyTexture(SDL_Texture *texture);
+        /// nullptr renders to the window again.
+        void SetRenderTarget(SDL_Texture *texture);
+        void SetTextureBlendMode(SDL_Texture *texture, SDL_BlendMode blendMode);
+        /// Color and alpha modulation of a texture, 255 meaning unchanged.
+        void SetTextureMod(SDL_Texture *texture, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+
+        /**
+         * @brief Copies every command recorded in another buffer to the end of this one.
+         * @param baseTarget Replaces the window (nullptr) as render target in the copied commands,
+         * so a buffer recorded for the window can be redirected into a texture.
+         */
+        void Append(const CommandBuffer &other, SDL_Texture *baseTarget = nullptr);
+
+        /**
+         * @brief Issues every recorded command on the renderer. The buffer is left untouched.
+         */
+        void Replay(SDL_Renderer *renderer) const;
+
+        /**
+         * @brief Forgets every recorded command, keeping the allocated memory.
+         */
+        void Reset();
+
+        bool IsEmpty() const { return commands.empty(); }
+        size_t GetCommandCount() const { return commands.size(); }
+        size_t GetVertexCount() const { return vertices.size(); }
+
+    private:
+        enum class Type : Uint8
+        {
+            SET_DRAW_COLOR,
+            SET_DRAW_BLEND_MODE,
+            CLEAR,
+            FILL_RECT,
+            TEXTURE,
+            GEOMETRY,
+            SET_CLIP_RECT,
+            SET_VIEWPORT,
+            DEBUG_TEXT,
+            DESTROY_TEXTURE,
+            SET_RENDER_TARGET,
+            SET_TEXTURE_BLEND_MODE,
+            SET_TEXTURE_MOD
+        };
+
+        struct Command
+        {
+            Type type;
+            bool hasSource{false}; ///< `source` is used (TEXTURE).
+            bool hasTarget{false}; ///< `target` or `rect` is used; otherwise the call gets nullptr.
+            Uint8 color[4]{};
+            SDL_BlendMode blendMode{SDL_BLENDMODE_NONE};
+            SDL_Texture *texture{nullptr};
+            SDL_FRect source{};
+            SDL_FRect target{}; ///< Also the position of DEBUG_TEXT.
+            SDL_Rect rect{};
+            Uint32 first{0};      ///< First vertex (GEOMETRY) or character (DEBUG_TEXT).
+            Uint32 count{0};      ///< Vertex count (GEOMETRY).
+            Uint32 firstIndex{0}; ///< GEOMETRY only.
+            Uint32 indexCount{0}; ///< GEOMETRY only.
+        };
+
+        std::vector<Command> commands;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+        std::vector<char> text;
+
+        Command &Push(Type type);
+    };
+
+} // namespace core::render
+
+#endif // CORE_RENDER_COMMAND_BUFFER_H
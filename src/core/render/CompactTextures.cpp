@@ -0,0 +1,131 @@
+#include "core/render/CompactTextures.h"
+
+#include <cstdlib>
+#include <vector>
+
+namespace core::render::compact
+{
+
+    /// Share of neighbouring pixels that may band before an image is kept at 8 bits per channel.
+    static constexpr Uint64 MAX_SMOOTH_PERCENT = 10;
+
+    static bool enabled = false;
+
+    void SetEnabled(bool enable)
+    {
+        enabled = enable;
+    }
+
+    bool IsEnabled()
+    {
+        return enabled;
+    }
+
+    static bool Supports(SDL_Renderer *renderer, SDL_PixelFormat format)
+    {
+        const SDL_PixelFormat *formats = static_cast<const SDL_PixelFormat *>(
+            SDL_GetPointerProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_TEXTURE_FORMATS_POINTER, nullptr));
+        for (; formats && *formats != SDL_PIXELFORMAT_UNKNOWN; formats++)
+        {
+            if (*formats == format)
+                return true;
+        }
+        return false;
+    }
+
+    /// Horizontal neighbours that differ, but by less than one step of the reduced precision, are where banding shows.
+    static bool HasSmoothGradients(const Uint8 *pixels, int width, int height, int pitch, int step, int channels)
+    {
+        Uint64 pairs = 0, smooth = 0;
+        for (int y = 0; y < height; y++)
+        {
+            const Uint8 *row = pixels + static_cast<size_t>(y) * pitch;
+            for (int x = 4; x < width * 4; x += 4)
+            {
+                for (int c = 0; c < channels; c++)
+                {
+                    const int delta = std::abs(int(row[x + c]) - int(row[x - 4 + c]));
+                    if (delta > 0 && delta < step)
+                    {
+                        smooth++;
+                        break;
+                    }
+                }
+                pairs++;
+            }
+        }
+        return smooth * 100 > pairs * MAX_SMOOTH_PERCENT;
+    }
+
+    SDL_PixelFormat ChooseFormat(SDL_Renderer *renderer, const Uint8 *pixels, int width, int height, int pitch)
+    {
+        if (!enabled)
+            return SDL_PIXELFORMAT_RGBA32;
+
+        bool opaque = true;
+        for (int y = 0; y < height && opaque; y++)
+        {
+            const Uint8 *row = pixels + static_cast<size_t>(y) * pitch;
+            for (int x = 3; x < width * 4; x += 4)
+            {
+                if (row[x] != 255)
+                {
+                    opaque = false;
+                    break;
+                }
+            }
+        }
+
+        // 5 bits per channel step by 8, 4 bits by 17.
+        if (opaque && Supports(renderer, SDL_PIXELFORMAT_RGB565) && !HasSmoothGradients(pixels, width, height, pitch, 8, 3))
+            return SDL_PIXELFORMAT_RGB565;
+        if (!opaque && Supports(renderer, SDL_PIXELFORMAT_ARGB4444) && !HasSmoothGradients(pixels, width, height, pitch, 17, 4))
+            return SDL_PIXELFORMAT_ARGB4444;
+        return SDL_PIXELFORMAT_RGBA32;
+    }
+
+    SDL_PixelFormat ChooseAlphaOnlyFormat(SDL_Renderer *renderer, const Uint8 *pixels, int width, int height, int pitch)
+    {
+        if (!enabled || !Supports(renderer, SDL_PIXELFORMAT_ARGB4444))
+            return SDL_PIXELFORMAT_RGBA32;
+
+        for (int y = 0; y < height; y++)
+        {
+            const Uint8 *row = pixels + static_cast<size_t>(y) * pitch;
+            for (int x = 0; x < width * 4; x += 4)
+            {
+                const Uint8 alpha = row[x + 3];
+                if (row[x] != alpha || row[x + 1] != alpha || row[x + 2] != alpha)
+                    return SDL_PIXELFORMAT_RGBA32;
+            }
+        }
+        // Glyph edges are the only gradients; 16 coverage levels keep them smooth enough.
+        return SDL_PIXELFORMAT_ARGB4444;
+    }
+
+    bool UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const Uint8 *pixels, int pitch)
+    {
+        if (texture->format == SDL_PIXELFORMAT_RGBA32)
+            return SDL_UpdateTexture(texture, rect, pixels, pitch);
+
+        const int width = rect ? rect->w : texture->w;
+        const int height = rect ? rect->h : texture->h;
+        const int convertedPitch = width * SDL_BYTESPERPIXEL(texture->format);
+        std::vector<Uint8> converted(static_cast<size_t>(convertedPitch) * height);
+        return SDL_ConvertPixels(width, height, SDL_PIXELFORMAT_RGBA32, pixels, pitch, texture->format, converted.data(), convertedPitch) &&
+               SDL_UpdateTexture(texture, rect, converted.data(), convertedPitch);
+    }
+
+    SDL_Texture *CreateTexture(SDL_Renderer *renderer, const Uint8 *pixels, int width, int height, int pitch)
+    {
+        const SDL_PixelFormat format = ChooseFormat(renderer, pixels, width, height, pitch);
+        SDL_Texture *texture = SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_STATIC, width, height);
+        if (texture && !UpdateTexture(texture, nullptr, pixels, pitch))
+        {
+            SDL_DestroyTexture(texture);
+            return nullptr;
+        }
+        return texture;
+    }
+
+} // namespace core::render::compact
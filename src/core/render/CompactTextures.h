@@ -0,0 +1,48 @@
+#ifndef CORE_RENDER_COMPACT_TEXTURES_H
+#define CORE_RENDER_COMPACT_TEXTURES_H
+
+#include <SDL3/SDL.h>
+
+/**
+ * @brief Opt-in 16-bit texture formats for low-memory devices.
+ *
+ * When enabled, every image is analyzed before its texture is created: opaque images become
+ * RGB565 and translucent ones ARGB4444, unless they contain smooth gradients that would band at
+ * that precision, in which case they stay RGBA32. Alpha-only images (white glyphs in premultiplied
+ * RGBA, i.e. font atlases) become ARGB4444. Formats the renderer can't create natively are never
+ * chosen. Disabled, everything stays RGBA32.
+ */
+namespace core::render::compact
+{
+
+    /// Set once at startup, before any texture is created.
+    void SetEnabled(bool enabled);
+    bool IsEnabled();
+
+    /**
+     * @brief The format to store RGBA32 pixels (straight or premultiplied) in.
+     */
+    SDL_PixelFormat ChooseFormat(SDL_Renderer *renderer, const Uint8 *pixels, int width, int height, int pitch);
+
+    /**
+     * @brief Like ChooseFormat(), for textures whose color channels all equal their alpha.
+     * Returns RGBA32 for any other content.
+     */
+    SDL_PixelFormat ChooseAlphaOnlyFormat(SDL_Renderer *renderer, const Uint8 *pixels, int width, int height, int pitch);
+
+    /**
+     * @brief Converts RGBA32 pixels to `format` and uploads them into `texture`, which has that format.
+     * @param rect Area of the texture to update, nullptr for all of it; `pixels` points at its first pixel.
+     */
+    bool UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const Uint8 *pixels, int pitch);
+
+    /**
+     * @brief Creates a static texture from RGBA32 pixels in the format ChooseFormat() picks.
+     * The caller holds the RenderLock and sets the blend mode.
+     * @return nullptr with SDL_GetError() set on failure.
+     */
+    SDL_Texture *CreateTexture(SDL_Renderer *renderer, const Uint8 *pixels, int width, int height, int pitch);
+
+} // namespace core::render::compact
+
+#endif // CORE_RENDER_COMPACT_TEXTURES_H
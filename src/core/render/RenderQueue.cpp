@@ -0,0 +1,155 @@
+#include "core/render/RenderQueue.h"
+#include "core/memory/AllocationTracker.h"
+
+namespace core::render
+{
+
+    RenderQueue::RenderQueue(SDL_Renderer *renderer) : renderer(renderer)
+    {
+        rendererMutex = SDL_CreateMutex();
+        mutex = SDL_CreateMutex();
+        condition = SDL_CreateCondition();
+    }
+
+    RenderQueue::~RenderQueue()
+    {
+        StopThread();
+        SDL_DestroyCondition(condition);
+        SDL_DestroyMutex(mutex);
+        SDL_DestroyMutex(rendererMutex);
+    }
+
+    bool RenderQueue::StartThread()
+    {
+        if (thread)
+            return true;
+        if (!rendererMutex || !mutex || !condition)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "RenderQueue: synchronization primitives are missing");
+            return false;
+        }
+
+        quit = false;
+        thread = SDL_CreateThread(ThreadMain, "render", this);
+        if (!thread)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "RenderQueue: couldn't create the render thread: %s", SDL_GetError());
+            return false;
+        }
+        return true;
+    }
+
+    void RenderQueue::StopThread()
+    {
+        if (!thread)
+            return;
+
+        SDL_LockMutex(mutex);
+        quit = true;
+        SDL_SignalCondition(condition);
+        SDL_UnlockMutex(mutex);
+
+        SDL_WaitThread(thread, nullptr);
+        thread = nullptr;
+        pending = nullptr;
+    }
+
+    void RenderQueue::Submit()
+    {
+        CommandBuffer &buffer = buffers[recording];
+
+        if (!thread)
+        {
+            ReplayAndPresent(buffer);
+            buffer.Reset();
+            SDL_LockMutex(mutex);
+            stats.frames++;
+            stats.lastWaitNS = 0;
+            SDL_UnlockMutex(mutex);
+            return;
+        }
+
+        const Uint64 waitStart = SDL_GetTicksNS();
+        SDL_LockMutex(mutex);
+        // One frame in flight at most: the other buffer is free once the previous frame is presented.
+        while (pending)
+        {
+            SDL_WaitCondition(condition, mutex);
+        }
+        pending = &buffer;
+        stats.frames++;
+        stats.lastWaitNS = SDL_GetTicksNS() - waitStart;
+        SDL_SignalCondition(condition);
+        SDL_UnlockMutex(mutex);
+
+        recording ^= 1;
+        buffers[recording].Reset();
+    }
+
+    bool RenderQueue::GetOutputSize(int *width, int *height)
+    {
+        RenderLock lock{this};
+        return SDL_GetCurrentRenderOutputSize(renderer, width, height);
+    }
+
+    RenderQueue::Stats RenderQueue::GetStats()
+    {
+        SDL_LockMutex(mutex);
+        const Stats copy = stats;
+        SDL_UnlockMutex(mutex);
+        return copy;
+    }
+
+    void RenderQueue::ReplayAndPresent(const CommandBuffer &buffer)
+    {
+        const Uint64 start = SDL_GetTicksNS();
+        {
+            RenderLock lock{this};
+            buffer.Replay(renderer);
+            SDL_RenderPresent(renderer);
+        }
+        const Uint64 elapsed = SDL_GetTicksNS() - start;
+
+        SDL_LockMutex(mutex);
+        stats.lastReplayNS = elapsed;
+        SDL_UnlockMutex(mutex);
+    }
+
+    int SDLCALL RenderQueue::ThreadMain(void *userdata)
+    {
+        static_cast<RenderQueue *>(userdata)->RunThread();
+        return 0;
+    }
+
+    void RenderQueue::RunThread()
+    {
+        core::memory::tracking::SetThreadName("render");
+
+        for (;;)
+        {
+            SDL_LockMutex(mutex);
+            while (!pending && !quit)
+            {
+                SDL_WaitCondition(condition, mutex);
+            }
+            CommandBuffer *buffer = pending;
+            SDL_UnlockMutex(mutex);
+
+            // A frame submitted before quitting is still presented.
+            if (!buffer)
+                return;
+
+            ReplayAndPresent(*buffer);
+
+            SDL_LockMutex(mutex);
+            pending = nullptr;
+            SDL_SignalCondition(condition);
+            const bool stop = quit;
+            SDL_UnlockMutex(mutex);
+
+            if (stop)
+                return;
+        }
+    }
+
+} // namespace core::render
@@ -0,0 +1,127 @@
+#ifndef CORE_RENDER_RENDER_QUEUE_H
+#define CORE_RENDER_RENDER_QUEUE_H
+
+#include <SDL3/SDL.h>
+#include "core/render/CommandBuffer.h"
+
+namespace core::render
+{
+
+    /**
+     * @brief Double-buffered command buffers between the frame logic and the SDL_Renderer.
+     *
+     * Scenes and the RmlUi backend record the frame into Recording(); Submit() hands the buffer
+     * over and starts recording into the other one. By default the buffer is replayed and
+     * presented inside Submit(), on the main thread.
+     *
+     * With StartThread() a dedicated render thread replays and presents frame N while the main
+     * thread updates and records frame N+1. SDL only guarantees the renderer to work from the
+     * main thread, so this mode is opt-in and only for drivers known to tolerate it. While it is
+     * active, every direct SDL_Renderer call made elsewhere (creating textures, querying the
+     * output size) must hold a RenderLock.
+     */
+    class RenderQueue
+    {
+    public:
+        struct Stats
+        {
+            Uint64 frames{0};       ///< Frames submitted.
+            Uint64 lastWaitNS{0};   ///< Time the last Submit() waited for the render thread.
+            Uint64 lastReplayNS{0}; ///< Time spent replaying and presenting the last finished frame.
+        };
+
+        explicit RenderQueue(SDL_Renderer *renderer);
+        ~RenderQueue();
+
+        /// Non-copyable
+        RenderQueue(const RenderQueue &) = delete;
+        RenderQueue &operator=(const RenderQueue &) = delete;
+
+        /**
+         * @brief Moves replay and presentation to a dedicated thread.
+         * @return false if the thread couldn't be created; the queue then stays inline.
+         */
+        bool StartThread();
+
+        /**
+         * @brief Finishes the frame in flight and goes back to replaying inline.
+         */
+        void StopThread();
+
+        bool IsThreaded() const { return thread != nullptr; }
+
+        /**
+         * @brief Buffer the current frame is recorded into. Only valid until the next Submit().
+         */
+        CommandBuffer &Recording() { return buffers[recording]; }
+
+        /**
+         * @brief Destroys a texture once the commands recorded before this call have been replayed.
+         */
+        void DestroyTexture(SDL_Texture *texture) { Recording().DestroyTexture(texture); }
+
+        /**
+         * @brief Queues the recorded frame for replay and presentation.
+         * Waits if the render thread is still busy with the previous frame.
+         */
+        void Submit();
+
+        /**
+         * @brief Gives the caller exclusive access to the SDL_Renderer. Prefer RenderLock.
+         */
+        void Lock() { SDL_LockMutex(rendererMutex); }
+        void Unlock() { SDL_UnlockMutex(rendererMutex); }
+
+        /**
+         * @brief SDL_GetCurrentRenderOutputSize, safe to call while the render thread runs.
+         */
+        bool GetOutputSize(int *width, int *height);
+
+        SDL_Renderer *GetRenderer() const { return renderer; }
+        Stats GetStats();
+
+    private:
+        SDL_Renderer *renderer;
+        CommandBuffer buffers[2];
+        int recording{0};
+
+        SDL_Mutex *rendererMutex{nullptr}; ///< Held while using the renderer.
+        SDL_Mutex *mutex{nullptr};         ///< Protects the fields below.
+        SDL_Condition *condition{nullptr};
+        SDL_Thread *thread{nullptr};
+        CommandBuffer *pending{nullptr}; ///< Frame owned by the render thread until it is presented.
+        bool quit{false};
+        Stats stats;
+
+        void ReplayAndPresent(const CommandBuffer &buffer);
+        static int SDLCALL ThreadMain(void *userdata);
+        void RunThread();
+    };
+
+    /**
+     * @brief Holds the renderer lock of a queue for the lifetime of the object.
+     */
+    class RenderLock
+    {
+    public:
+        explicit RenderLock(RenderQueue *queue) : queue(queue)
+        {
+            if (queue)
+                queue->Lock();
+        }
+        ~RenderLock()
+        {
+            if (queue)
+                queue->Unlock();
+        }
+
+        RenderLock(const RenderLock &) = delete;
+        RenderLock &operator=(const RenderLock &) = delete;
+
+    private:
+        RenderQueue *queue;
+    };
+
+} // namespace core::render
+
+#endif // CORE_RENDER_RENDER_QUEUE_H
@@ -0,0 +1,101 @@
+#include "core/render/RenderTargetPool.h"
+#include "core/render/RenderQueue.h"
+
+#include <algorithm>
+
+namespace core::render
+{
+
+    static size_t EstimateBytes(int width, int height, SDL_PixelFormat format)
+    {
+        return static_cast<size_t>(width) * height * SDL_BYTESPERPIXEL(format);
+    }
+
+    RenderTargetPool::RenderTargetPool(SDL_Renderer *renderer, RenderQueue *queue) : renderer(renderer), queue(queue)
+    {
+    }
+
+    RenderTargetPool::~RenderTargetPool()
+    {
+        for (Entry &entry : entries)
+            Destroy(entry);
+    }
+
+    SDL_Texture *RenderTargetPool::Acquire(int width, int height, SDL_PixelFormat format)
+    {
+        stats.requests++;
+
+        for (Entry &entry : entries)
+        {
+            if (!entry.inUse && entry.width == width && entry.height == height && entry.format == format)
+            {
+                entry.inUse = true;
+                entry.idleFrames = 0;
+                stats.hits++;
+                return entry.texture;
+            }
+        }
+
+        SDL_Texture *texture;
+        {
+            RenderLock lock{queue};
+            texture = SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_TARGET, width, height);
+        }
+        if (!texture)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "RenderTargetPool: couldn't create a %dx%d target: %s", width, height, SDL_GetError());
+            return nullptr;
+        }
+
+        entries.push_back({texture, width, height, format, true, 0});
+        stats.textures++;
+        stats.bytes += EstimateBytes(width, height, format);
+        stats.peakBytes = std::max(stats.peakBytes, stats.bytes);
+        return texture;
+    }
+
+    void RenderTargetPool::Release(SDL_Texture *texture)
+    {
+        for (Entry &entry : entries)
+        {
+            if (entry.texture == texture)
+            {
+                entry.inUse = false;
+                return;
+            }
+        }
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "RenderTargetPool: released a texture it doesn't own");
+    }
+
+    void RenderTargetPool::EndFrame(int maxIdleFrames)
+    {
+        for (Entry &entry : entries)
+        {
+            if (!entry.inUse && ++entry.idleFrames > maxIdleFrames)
+                Destroy(entry);
+        }
+        std::erase_if(entries, [](const Entry &entry)
+                      { return entry.texture == nullptr; });
+    }
+
+    void RenderTargetPool::Trim()
+    {
+        EndFrame(-1);
+    }
+
+    void RenderTargetPool::Destroy(Entry &entry)
+    {
+        if (!entry.texture)
+            return;
+
+        if (queue)
+            queue->DestroyTexture(entry.texture);
+        else
+            SDL_DestroyTexture(entry.texture);
+
+        stats.textures--;
+        stats.bytes -= EstimateBytes(entry.width, entry.height, entry.format);
+        entry.texture = nullptr;
+    }
+
+} // namespace core::render
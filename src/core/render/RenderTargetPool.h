@@ -0,0 +1,94 @@
+#ifndef CORE_RENDER_RENDER_TARGET_POOL_H
+#define CORE_RENDER_RENDER_TARGET_POOL_H
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+namespace core::render
+{
+
+    class RenderQueue;
+
+    /**
+     * @brief Recycles SDL_TEXTUREACCESS_TARGET textures by size and format.
+     *
+     * Offscreen passes (layers, masks, blur levels) acquire a target, draw, and release it when
+     * done. Released targets are reused by the next request with the same key, so a steady
+     * frame creates no GPU memory. Targets idle for too many frames are destroyed by EndFrame().
+     *
+     * Releasing is safe as soon as the caller is done recording with the texture: commands are
+     * replayed in order, so a later user of the same target draws after the earlier ones.
+     */
+    class RenderTargetPool
+    {
+    public:
+        struct Stats
+        {
+            Uint64 requests{0};
+            Uint64 hits{0};       ///< Requests served by a recycled target.
+            size_t textures{0};   ///< Targets currently alive, in use or idle.
+            size_t bytes{0};      ///< Estimated GPU memory of the live targets.
+            size_t peakBytes{0};
+        };
+
+        /**
+         * @param queue Used to lock the renderer while creating and to defer destruction; may be null.
+         */
+        RenderTargetPool(SDL_Renderer *renderer, RenderQueue *queue);
+        ~RenderTargetPool();
+
+        /// Non-copyable
+        RenderTargetPool(const RenderTargetPool &) = delete;
+        RenderTargetPool &operator=(const RenderTargetPool &) = delete;
+
+        /**
+         * @brief Returns an unused target of exactly this size and format, or nullptr on failure.
+         * The content is undefined; clear it before use.
+         */
+        SDL_Texture *Acquire(int width, int height, SDL_PixelFormat format = SDL_PIXELFORMAT_RGBA32);
+
+        /**
+         * @brief Gives a target obtained from Acquire() back to the pool.
+         */
+        void Release(SDL_Texture *texture);
+
+        /**
+         * @brief Destroys targets that have not been acquired for `maxIdleFrames` calls.
+         */
+        void EndFrame(int maxIdleFrames = 120);
+
+        /**
+         * @brief Destroys every idle target.
+         */
+        void Trim();
+
+        /**
+         * @brief Changes the queue used for locking and destruction. Existing targets are kept.
+         */
+        void SetQueue(RenderQueue *queue) { this->queue = queue; }
+
+        const Stats &GetStats() const { return stats; }
+        float GetHitRate() const { return stats.requests ? static_cast<float>(stats.hits) / stats.requests : 0.0f; }
+
+    private:
+        struct Entry
+        {
+            SDL_Texture *texture;
+            int width;
+            int height;
+            SDL_PixelFormat format;
+            bool inUse;
+            int idleFrames;
+        };
+
+        SDL_Renderer *renderer;
+        RenderQueue *queue;
+        std::vector<Entry> entries;
+        Stats stats;
+
+        void Destroy(Entry &entry);
+    };
+
+} // namespace core::render
+
+#endif // CORE_RENDER_RENDER_TARGET_POOL_H
@@ -0,0 +1,396 @@
+#include "core/render/SoftwareRasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CORE_RASTERIZER_SSE2 1
+#include <emmintrin.h>
+#else
+#define CORE_RASTERIZER_SSE2 0
+#endif
+
+namespace core::render
+{
+
+    using Pixel = SoftwareRasterizer::Pixel;
+
+    static constexpr Pixel WHITE = 0xFFFFFFFF;
+
+    /// x / 255, rounded, for x in [0, 255 * 255].
+    static inline unsigned Div255(unsigned x)
+    {
+        x += 128;
+        return (x + (x >> 8)) >> 8;
+    }
+
+    static inline Pixel MakePixel(float r, float g, float b, float a)
+    {
+        const Uint8 bytes[4] = {
+            static_cast<Uint8>(std::clamp(r, 0.0f, 255.0f) + 0.5f),
+            static_cast<Uint8>(std::clamp(g, 0.0f, 255.0f) + 0.5f),
+            static_cast<Uint8>(std::clamp(b, 0.0f, 255.0f) + 0.5f),
+            static_cast<Uint8>(std::clamp(a, 0.0f, 255.0f) + 0.5f),
+        };
+        Pixel pixel;
+        std::memcpy(&pixel, bytes, sizeof(pixel));
+        return pixel;
+    }
+
+    static inline Pixel Modulate(Pixel texel, Pixel color)
+    {
+        const Uint8 *t = reinterpret_cast<const Uint8 *>(&texel);
+        const Uint8 *c = reinterpret_cast<const Uint8 *>(&color);
+        Uint8 out[4];
+        for (int i = 0; i < 4; i++)
+            out[i] = static_cast<Uint8>(Div255(t[i] * c[i]));
+        Pixel pixel;
+        std::memcpy(&pixel, out, sizeof(pixel));
+        return pixel;
+    }
+
+    static inline Pixel BlendPixel(Pixel dst, Pixel src)
+    {
+        const Uint8 *s = reinterpret_cast<const Uint8 *>(&src);
+        const Uint8 *d = reinterpret_cast<const Uint8 *>(&dst);
+        const unsigned inverseAlpha = 255 - s[3];
+        Uint8 out[4];
+        for (int i = 0; i < 4; i++)
+            out[i] = static_cast<Uint8>(std::min(255u, s[i] + Div255(d[i] * inverseAlpha)));
+        Pixel pixel;
+        std::memcpy(&pixel, out, sizeof(pixel));
+        return pixel;
+    }
+
+#if CORE_RASTERIZER_SSE2
+    /// dst * (255 - src.a) / 255 + src for four pixels, `src` already unpacked to 16 bits per channel.
+    static inline __m128i BlendPixels4(__m128i dst, __m128i srcLo, __m128i srcHi, __m128i srcPacked)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i full = _mm_set1_epi16(255);
+        const __m128i bias = _mm_set1_epi16(128);
+
+        const __m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(srcLo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(srcHi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+        __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), _mm_sub_epi16(full, alphaLo));
+        __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), _mm_sub_epi16(full, alphaHi));
+        lo = _mm_add_epi16(lo, bias);
+        hi = _mm_add_epi16(hi, bias);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+        return _mm_adds_epu8(srcPacked, _mm_packus_epi16(lo, hi));
+    }
+#endif
+
+    static void BlendSpan(Pixel *dst, const Pixel *src, int count)
+    {
+        int i = 0;
+#if CORE_RASTERIZER_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(s, zero)) == 0xFFFF)
+                continue; // Fully transparent, common around glyphs.
+            const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+            const __m128i result = BlendPixels4(d, _mm_unpacklo_epi8(s, zero), _mm_unpackhi_epi8(s, zero), s);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), result);
+        }
+#endif
+        for (; i < count; i++)
+        {
+            if (src[i] != 0)
+                dst[i] = BlendPixel(dst[i], src[i]);
+        }
+    }
+
+    static void BlendSolid(Pixel *dst, Pixel color, int count)
+    {
+        const Uint8 alpha = reinterpret_cast<const Uint8 *>(&color)[3];
+        if (alpha == 255)
+        {
+            std::fill(dst, dst + count, color);
+            return;
+        }
+        if (color == 0)
+            return;
+
+        int i = 0;
+#if CORE_RASTERIZER_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i s = _mm_set1_epi32(static_cast<int>(color));
+        const __m128i sLo = _mm_unpacklo_epi8(s, zero);
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), BlendPixels4(d, sLo, sLo, s));
+        }
+#endif
+        for (; i < count; i++)
+            dst[i] = BlendPixel(dst[i], color);
+    }
+
+    void SoftwareRasterizer::SetScheduler(jobs::Scheduler *newScheduler)
+    {
+        scheduler = newScheduler;
+        stats.threads = scheduler ? scheduler->GetWorkerCount() + 1 : 1;
+    }
+
+    void SoftwareRasterizer::Begin(int newWidth, int newHeight)
+    {
+        newWidth = std::max(newWidth, 0);
+        newHeight = std::max(newHeight, 0);
+        if (newWidth != width || newHeight != height)
+        {
+            width = newWidth;
+            height = newHeight;
+            tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+            tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+            framebuffer.assign(static_cast<size_t>(width) * height, 0);
+            bins.resize(static_cast<size_t>(tilesX) * tilesY);
+        }
+
+        for (std::vector<Uint32> &bin : bins)
+            bin.clear();
+        triangles.clear();
+        scissorEnabled = false;
+        stats.triangles = 0;
+        stats.binned = 0;
+    }
+
+    void SoftwareRasterizer::SetScissor(const SDL_Rect *rect)
+    {
+        scissorEnabled = (rect != nullptr);
+        if (rect)
+            scissor = *rect;
+    }
+
+    void SoftwareRasterizer::DrawTriangles(const Vertex *vertices, int vertexCount, const int *indices, int indexCount, const Texture *texture)
+    {
+        int clipX0 = 0, clipY0 = 0, clipX1 = width, clipY1 = height;
+        if (scissorEnabled)
+        {
+            clipX0 = std::max(clipX0, scissor.x);
+            clipY0 = std::max(clipY0, scissor.y);
+            clipX1 = std::min(clipX1, scissor.x + scissor.w);
+            clipY1 = std::min(clipY1, scissor.y + scissor.h);
+        }
+        if (clipX0 >= clipX1 || clipY0 >= clipY1)
+            return;
+
+        if (texture && (texture->width <= 0 || texture->height <= 0))
+            texture = nullptr;
+
+        for (int i = 0; i + 2 < indexCount; i += 3)
+        {
+            if (indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount)
+                continue;
+
+            const Vertex *v[3] = {&vertices[indices[i]], &vertices[indices[i + 1]], &vertices[indices[i + 2]]};
+            float area = (v[1]->x - v[0]->x) * (v[2]->y - v[0]->y) - (v[2]->x - v[0]->x) * (v[1]->y - v[0]->y);
+            if (std::fabs(area) < 1e-6f)
+                continue;
+            if (area < 0.0f)
+            {
+                std::swap(v[1], v[2]);
+                area = -area;
+            }
+
+            Triangle triangle;
+            triangle.texture = texture;
+            for (int k = 0; k < 3; k++)
+            {
+                triangle.x[k] = v[k]->x;
+                triangle.y[k] = v[k]->y;
+            }
+
+            // Pixels whose centers may be covered.
+            const float minX = std::min({v[0]->x, v[1]->x, v[2]->x});
+            const float maxX = std::max({v[0]->x, v[1]->x, v[2]->x});
+            const float minY = std::min({v[0]->y, v[1]->y, v[2]->y});
+            const float maxY = std::max({v[0]->y, v[1]->y, v[2]->y});
+            triangle.x0 = std::max(clipX0, static_cast<int>(std::ceil(std::max(minX, -1.0f) - 0.5f)));
+            triangle.y0 = std::max(clipY0, static_cast<int>(std::ceil(std::max(minY, -1.0f) - 0.5f)));
+            triangle.x1 = std::min(clipX1, static_cast<int>(std::ceil(std::min(maxX, static_cast<float>(width) + 1.0f) - 0.5f)));
+            triangle.y1 = std::min(clipY1, static_cast<int>(std::ceil(std::min(maxY, static_cast<float>(height) + 1.0f) - 0.5f)));
+            if (triangle.x0 >= triangle.x1 || triangle.y0 >= triangle.y1)
+                continue;
+
+            // Attributes are interpolated linearly in screen space: f(x, y) = c + dx * x + dy * y.
+            auto MakePlane = [&](float f0, float f1, float f2) {
+                const float dx = ((f1 - f0) * (v[2]->y - v[0]->y) - (f2 - f0) * (v[1]->y - v[0]->y)) / area;
+                const float dy = ((f2 - f0) * (v[1]->x - v[0]->x) - (f1 - f0) * (v[2]->x - v[0]->x)) / area;
+                return Plane{f0 - dx * v[0]->x - dy * v[0]->y, dx, dy};
+            };
+
+            triangle.color = v[0]->color;
+            triangle.flat = (v[0]->color == v[1]->color && v[0]->color == v[2]->color);
+            if (!triangle.flat)
+            {
+                const Uint8 *c[3] = {reinterpret_cast<const Uint8 *>(&v[0]->color), reinterpret_cast<const Uint8 *>(&v[1]->color),
+                                     reinterpret_cast<const Uint8 *>(&v[2]->color)};
+                for (int channel = 0; channel < 4; channel++)
+                    triangle.planes[channel] = MakePlane(c[0][channel], c[1][channel], c[2][channel]);
+            }
+            if (texture)
+            {
+                triangle.planes[4] = MakePlane(v[0]->u, v[1]->u, v[2]->u);
+                triangle.planes[5] = MakePlane(v[0]->v, v[1]->v, v[2]->v);
+            }
+
+            const Uint32 index = static_cast<Uint32>(triangles.size());
+            triangles.push_back(triangle);
+
+            const int tileX1 = (triangle.x1 - 1) / TILE_SIZE;
+            const int tileY1 = (triangle.y1 - 1) / TILE_SIZE;
+            for (int ty = triangle.y0 / TILE_SIZE; ty <= tileY1; ty++)
+            {
+                for (int tx = triangle.x0 / TILE_SIZE; tx <= tileX1; tx++)
+                {
+                    bins[ty * tilesX + tx].push_back(index);
+                    stats.binned++;
+                }
+            }
+        }
+    }
+
+    void SoftwareRasterizer::Finish()
+    {
+        const Uint64 start = SDL_GetTicksNS();
+
+        if (triangles.empty())
+        {
+            std::fill(framebuffer.begin(), framebuffer.end(), 0);
+        }
+        else
+        {
+            const size_t tileCount = static_cast<size_t>(tilesX) * tilesY;
+            auto rasterize = [this](size_t first, size_t last)
+            {
+                for (size_t tile = first; tile < last; tile++)
+                    RasterizeTile(static_cast<int>(tile));
+            };
+            // One tile per job: their cost varies a lot, and idle workers steal the remaining ones.
+            if (scheduler)
+                scheduler->ParallelFor(0, tileCount, 1, rasterize);
+            else
+                rasterize(0, tileCount);
+        }
+
+        stats.triangles = triangles.size();
+        stats.rasterNS = SDL_GetTicksNS() - start;
+    }
+
+    void SoftwareRasterizer::RasterizeTile(int tile)
+    {
+        const int x0 = (tile % tilesX) * TILE_SIZE;
+        const int y0 = (tile / tilesX) * TILE_SIZE;
+        const int x1 = std::min(x0 + TILE_SIZE, width);
+        const int y1 = std::min(y0 + TILE_SIZE, height);
+
+        // Each tile clears its own pixels, which spreads the clear over the threads too.
+        for (int y = y0; y < y1; y++)
+            std::memset(&framebuffer[static_cast<size_t>(y) * width + x0], 0, sizeof(Pixel) * (x1 - x0));
+
+        for (Uint32 index : bins[tile])
+            RasterizeTriangle(triangles[index], x0, y0, x1, y1);
+    }
+
+    void SoftwareRasterizer::RasterizeTriangle(const Triangle &triangle, int tileX0, int tileY0, int tileX1, int tileY1)
+    {
+        const int rowX0 = std::max(triangle.x0, tileX0);
+        const int rowX1 = std::min(triangle.x1, tileX1);
+        const int rowY0 = std::max(triangle.y0, tileY0);
+        const int rowY1 = std::min(triangle.y1, tileY1);
+        const Texture *texture = triangle.texture;
+        Pixel span[TILE_SIZE];
+
+        for (int y = rowY0; y < rowY1; y++)
+        {
+            // Solve the three edge functions for the covered interval of this row. Left edges include pixel
+            // centers lying exactly on them, right edges don't, so triangles sharing an edge never overlap.
+            const float cy = y + 0.5f;
+            float left = static_cast<float>(rowX0);
+            float right = static_cast<float>(rowX1);
+            bool empty = false;
+            for (int e = 0; e < 3; e++)
+            {
+                const int a = e, b = (e + 1) % 3;
+                const float coefficient = triangle.y[a] - triangle.y[b];
+                const float constant = (triangle.x[b] - triangle.x[a]) * (cy - triangle.y[a]) + (triangle.y[b] - triangle.y[a]) * triangle.x[a];
+                if (coefficient > 0.0f)
+                    left = std::max(left, -constant / coefficient);
+                else if (coefficient < 0.0f)
+                    right = std::min(right, -constant / coefficient);
+                else if (constant < 0.0f || (constant == 0.0f && triangle.x[b] <= triangle.x[a]))
+                    empty = true; // Outside a horizontal edge; on it only counts for top edges.
+            }
+            if (empty)
+                continue;
+
+            const int px0 = static_cast<int>(std::ceil(left - 0.5f));
+            const int px1 = static_cast<int>(std::ceil(right - 0.5f));
+            const int count = px1 - px0;
+            if (count <= 0)
+                continue;
+
+            Pixel *dst = &framebuffer[static_cast<size_t>(y) * width + px0];
+            if (!texture && triangle.flat)
+            {
+                BlendSolid(dst, triangle.color, count);
+                continue;
+            }
+
+            const float cx = px0 + 0.5f;
+            auto Evaluate = [&](int plane) { return triangle.planes[plane].c + triangle.planes[plane].dx * cx + triangle.planes[plane].dy * cy; };
+
+            float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
+            if (!triangle.flat)
+            {
+                r = Evaluate(0);
+                g = Evaluate(1);
+                b = Evaluate(2);
+                a = Evaluate(3);
+            }
+            float u = 0.0f, v = 0.0f;
+            if (texture)
+            {
+                u = Evaluate(4) * texture->width;
+                v = Evaluate(5) * texture->height;
+            }
+            const float du = texture ? triangle.planes[4].dx * texture->width : 0.0f;
+            const float dv = texture ? triangle.planes[5].dx * texture->height : 0.0f;
+
+            for (int i = 0; i < count; i++)
+            {
+                Pixel color = triangle.color;
+                if (!triangle.flat)
+                {
+                    color = MakePixel(r, g, b, a);
+                    r += triangle.planes[0].dx;
+                    g += triangle.planes[1].dx;
+                    b += triangle.planes[2].dx;
+                    a += triangle.planes[3].dx;
+                }
+
+                if (texture)
+                {
+                    // Nearest sampling, clamped to the edge.
+                    const int tx = std::clamp(static_cast<int>(u), 0, texture->width - 1);
+                    const int ty = std::clamp(static_cast<int>(v), 0, texture->height - 1);
+                    const Pixel texel = texture->pixels[static_cast<size_t>(ty) * texture->width + tx];
+                    color = (color == WHITE) ? texel : Modulate(texel, color);
+                    u += du;
+                    v += dv;
+                }
+                span[i] = color;
+            }
+
+            BlendSpan(dst, span, count);
+        }
+    }
+
+} // namespace core::render
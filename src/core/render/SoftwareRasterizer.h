@@ -0,0 +1,123 @@
+#ifndef CORE_RENDER_SOFTWARE_RASTERIZER_H
+#define CORE_RENDER_SOFTWARE_RASTERIZER_H
+
+#include "core/jobs/Scheduler.h"
+#include <SDL3/SDL.h>
+#include <vector>
+
+namespace core::render
+{
+
+    /**
+     * @brief Tiled, multi-threaded triangle rasterizer into a CPU framebuffer.
+     *
+     * Meant for UI rendering on machines without a GPU, where SDL's software renderer handles
+     * many small textured triangles poorly. Triangles recorded between Begin() and Finish() are
+     * binned into TILE_SIZE square tiles. Finish() then rasterizes the tiles as jobs on the scheduler,
+     * if one is set. Each tile is owned by a single job and processes its triangles in submission
+     * order, so blending matches a sequential renderer exactly.
+     *
+     * Textures, vertex colors and the framebuffer all use premultiplied alpha, composited with
+     * `dst = src + dst * (1 - src.a)`. Spans are blended four pixels at a time with SSE2 when the
+     * target supports it.
+     */
+    class SoftwareRasterizer
+    {
+    public:
+        /// Bytes in memory are R, G, B, A (SDL_PIXELFORMAT_RGBA32), premultiplied.
+        using Pixel = Uint32;
+
+        struct Vertex
+        {
+            float x, y;
+            float u, v; ///< Normalized texture coordinates.
+            Pixel color;
+        };
+
+        struct Texture
+        {
+            int width{0};
+            int height{0};
+            std::vector<Pixel> pixels;
+        };
+
+        struct Stats
+        {
+            Uint64 triangles{0}; ///< Triangles drawn last frame, after culling.
+            Uint64 binned{0};    ///< Triangle-tile pairs last frame.
+            Uint64 rasterNS{0};  ///< Time spent in the last Finish().
+            int threads{0};      ///< Threads rasterizing, including the caller of Finish().
+        };
+
+        static constexpr int TILE_SIZE = 64;
+
+        SoftwareRasterizer() = default;
+
+        /// Non-copyable
+        SoftwareRasterizer(const SoftwareRasterizer &) = delete;
+        SoftwareRasterizer &operator=(const SoftwareRasterizer &) = delete;
+
+        /**
+         * @brief Spreads the tiles over `scheduler`'s threads; nullptr rasterizes on the caller of Finish().
+         */
+        void SetScheduler(jobs::Scheduler *scheduler);
+
+        /**
+         * @brief Starts a frame. The framebuffer is cleared to transparent black by Finish().
+         */
+        void Begin(int width, int height);
+
+        /// nullptr disables the scissor.
+        void SetScissor(const SDL_Rect *rect);
+
+        /**
+         * @brief Records indexed triangles. The data is copied; `texture` must stay alive until Finish().
+         */
+        void DrawTriangles(const Vertex *vertices, int vertexCount, const int *indices, int indexCount, const Texture *texture);
+
+        /**
+         * @brief Rasterizes everything recorded since Begin(). Blocks until the framebuffer is complete.
+         */
+        void Finish();
+
+        const Pixel *GetPixels() const { return framebuffer.data(); }
+        int GetWidth() const { return width; }
+        int GetHeight() const { return height; }
+        const Stats &GetStats() const { return stats; }
+
+    private:
+        /// value(x, y) = c + dx * x + dy * y
+        struct Plane
+        {
+            float c, dx, dy;
+        };
+
+        struct Triangle
+        {
+            const Texture *texture;
+            float x[3], y[3]; ///< Counter-clockwise in the edge function convention.
+            int x0, y0, x1, y1; ///< Covered pixels, clipped to the scissor and the framebuffer. x1 and y1 are exclusive.
+            Plane planes[6];    ///< r, g, b, a, u, v
+            Pixel color;        ///< Used when `flat`.
+            bool flat;          ///< Every vertex has the same color.
+        };
+
+        int width{0};
+        int height{0};
+        int tilesX{0};
+        int tilesY{0};
+        std::vector<Pixel> framebuffer;
+        std::vector<Triangle> triangles;
+        std::vector<std::vector<Uint32>> bins; ///< Triangle indices per tile, in submission order.
+        SDL_Rect scissor{};
+        bool scissorEnabled{false};
+        Stats stats{.threads = 1};
+        jobs::Scheduler *scheduler{nullptr};
+
+        void RasterizeTile(int tile);
+        void RasterizeTriangle(const Triangle &triangle, int tileX0, int tileY0, int tileX1, int tileY1);
+    };
+
+} // namespace core::render
+
+#endif // CORE_RENDER_SOFTWARE_RASTERIZER_H
@@ -0,0 +1,372 @@
+#include "core/render/SvgCache.h"
+#include "core/render/CompactTextures.h"
+#include "core/render/RenderQueue.h"
+#include "core/assets/AssetPack.h"
+#include "core/assets/CookedTexture.h"
+#include "core/memory/AllocationTracker.h"
+#include "core/trace/StartupTrace.h"
+
+#include <SDL3_image/SDL_image.h>
+#include <algorithm>
+#include <cstring>
+
+namespace core::render
+{
+
+    SvgCache::SvgCache(SDL_Renderer *renderer, RenderQueue *queue, TextureManager *textures)
+        : renderer(renderer), queue(queue), textures(textures)
+    {
+        mutex = SDL_CreateMutex();
+        wake = SDL_CreateCondition();
+        rasterized = SDL_CreateCondition();
+        worker = mutex && wake && rasterized ? SDL_CreateThread(WorkerMain, "svg", this) : nullptr;
+        if (!worker)
+            SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "SvgCache: no worker thread, resized SVGs are rasterized on the main thread: %s", SDL_GetError());
+    }
+
+    SvgCache::~SvgCache()
+    {
+        if (worker)
+        {
+            SDL_LockMutex(mutex);
+            quit = true;
+            SDL_SignalCondition(wake);
+            SDL_UnlockMutex(mutex);
+            SDL_WaitThread(worker, nullptr);
+        }
+        SDL_DestroyCondition(rasterized);
+        SDL_DestroyCondition(wake);
+        SDL_DestroyMutex(mutex);
+
+        for (auto &[path, document] : documents)
+        {
+            for (const Raster &raster : document.rasters)
+                textures->Release(raster.texture);
+        }
+    }
+
+    void SvgCache::SetDiskCache(const std::string &directory)
+    {
+        diskCache = directory;
+        if (!diskCache.empty() && diskCache.back() != '/' && diskCache.back() != '\\')
+            diskCache += '/';
+        if (!diskCache.empty() && !SDL_CreateDirectory(diskCache.c_str()))
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "SvgCache: disk cache disabled, couldn't create %s: %s", diskCache.c_str(), SDL_GetError());
+            diskCache.clear();
+        }
+    }
+
+    bool SvgCache::Load(const std::string &path)
+    {
+        return Find(path) != nullptr;
+    }
+
+    bool SvgCache::Prefetch(const std::string &path, int width, int height)
+    {
+        Document *document = Find(path);
+        if (!document)
+            return false;
+        if (!worker || document->queued || !document->rasters.empty())
+            return true;
+
+        document->queued = true;
+        SDL_LockMutex(mutex);
+        jobs.push_back({document, std::clamp(width, 1, MAX_SIZE), std::clamp(height, 1, MAX_SIZE)});
+        SDL_SignalCondition(wake);
+        SDL_UnlockMutex(mutex);
+        return true;
+    }
+
+    SDL_Texture *SvgCache::Get(const std::string &path, int width, int height)
+    {
+        Document *document = Find(path);
+        if (!document)
+            return nullptr;
+
+        width = std::clamp(width, 1, MAX_SIZE);
+        height = std::clamp(height, 1, MAX_SIZE);
+
+        // Prefetched and still on the worker: waiting for it beats rasterizing a second time.
+        while (document->rasters.empty() && document->queued)
+            UploadResults(true);
+
+        Raster *closest = nullptr;
+        int closestDistance = 0;
+        for (Raster &raster : document->rasters)
+        {
+            const int distance = std::abs(raster.width - width) + std::abs(raster.height - height);
+            if (!closest || distance < closestDistance)
+            {
+                closest = &raster;
+                closestDistance = distance;
+            }
+        }
+
+        if (!closest)
+        {
+            Pixels pixels;
+            bool fromDisk = false;
+            if (!Rasterize(*document, width, height, pixels, fromDisk))
+                return nullptr;
+            fromDisk ? stats.diskHits++ : stats.rasterized++;
+            AddRaster(*document, width, height, pixels);
+            closest = &document->rasters.back();
+        }
+        else if (closestDistance == 0)
+        {
+            document->pendingWidth = document->pendingHeight = 0;
+        }
+        else if (document->pendingWidth != width || document->pendingHeight != height)
+        {
+            // Restart the settle timer whenever the size changes, e.g. on every step of a window resize.
+            document->pendingWidth = width;
+            document->pendingHeight = height;
+            document->pendingSince = SDL_GetTicks();
+        }
+
+        closest->lastUsedFrame = frame;
+        return textures->Get(closest->texture);
+    }
+
+    void SvgCache::UploadResults(bool wait)
+    {
+        if (!worker)
+            return;
+
+        std::vector<Result> finished;
+        SDL_LockMutex(mutex);
+        while (wait && results.empty())
+            SDL_WaitCondition(rasterized, mutex);
+        finished.swap(results);
+        SDL_UnlockMutex(mutex);
+
+        for (Result &result : finished)
+        {
+            Document &document = *result.document;
+            document.queued = false;
+            if (result.pixels.data.empty())
+                continue;
+
+            result.fromDisk ? stats.diskHits++ : stats.rasterized++;
+            const bool exists = std::any_of(document.rasters.begin(), document.rasters.end(), [&](const Raster &raster)
+                                            { return raster.width == result.width && raster.height == result.height; });
+            if (!exists)
+                AddRaster(document, result.width, result.height, result.pixels);
+        }
+    }
+
+    void SvgCache::Update()
+    {
+        UploadResults(false);
+
+        const Uint64 now = SDL_GetTicks();
+        std::vector<Job> settled;
+        for (auto &[path, document] : documents)
+        {
+            if (document.pendingWidth == 0 || document.queued || now - document.pendingSince < SETTLE_MS)
+                continue;
+
+            const Job job{&document, document.pendingWidth, document.pendingHeight};
+            document.pendingWidth = document.pendingHeight = 0;
+            if (std::any_of(document.rasters.begin(), document.rasters.end(), [&](const Raster &raster)
+                            { return raster.width == job.width && raster.height == job.height; }))
+                continue;
+
+            if (worker)
+            {
+                settled.push_back(job);
+                document.queued = true;
+                continue;
+            }
+
+            Pixels pixels;
+            bool fromDisk = false;
+            if (Rasterize(document, job.width, job.height, pixels, fromDisk))
+            {
+                fromDisk ? stats.diskHits++ : stats.rasterized++;
+                AddRaster(document, job.width, job.height, pixels);
+            }
+        }
+        if (!settled.empty())
+        {
+            SDL_LockMutex(mutex);
+            jobs.insert(jobs.end(), settled.begin(), settled.end());
+            SDL_SignalCondition(wake);
+            SDL_UnlockMutex(mutex);
+        }
+
+        // Release the sizes nobody draws anymore. The most recently drawn raster of a document stays,
+        // so going back to a scene doesn't start from nothing.
+        for (auto &[path, document] : documents)
+        {
+            std::vector<Raster> &rasters = document.rasters;
+            if (rasters.size() < 2)
+                continue;
+
+            const Uint64 newestFrame = std::max_element(rasters.begin(), rasters.end(), [](const Raster &a, const Raster &b)
+                                                        { return a.lastUsedFrame < b.lastUsedFrame; })
+                                           ->lastUsedFrame;
+            const size_t released = std::erase_if(rasters, [&](const Raster &raster)
+                                                  {
+                                                      if (raster.lastUsedFrame == newestFrame || frame - raster.lastUsedFrame <= UNUSED_FRAMES)
+                                                          return false;
+                                                      textures->Release(raster.texture);
+                                                      return true; });
+            stats.rasters -= released;
+        }
+
+        frame++;
+    }
+
+    SvgCache::Document *SvgCache::Find(const std::string &path)
+    {
+        const std::string name = assets::NormalizePath(path);
+        auto it = documents.find(name);
+        if (it != documents.end())
+            return &it->second;
+
+        SDL_IOStream *io = assets::OpenAsset(path);
+        size_t size = 0;
+        void *data = io ? SDL_LoadFile_IO(io, &size, true) : nullptr;
+        if (!data)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "SvgCache: couldn't read %s: %s", path.c_str(), SDL_GetError());
+            return nullptr;
+        }
+
+        Document &document = documents[name];
+        document.path = path;
+        document.data.assign(static_cast<const Uint8 *>(data), static_cast<const Uint8 *>(data) + size);
+        document.hash = assets::pack::HashName({reinterpret_cast<const char *>(document.data.data()), document.data.size()});
+        SDL_free(data);
+        stats.documents++;
+        return &document;
+    }
+
+    bool SvgCache::Rasterize(const Document &document, int width, int height, Pixels &pixels, bool &fromDisk) const
+    {
+        // Called from the worker too: only reads the immutable part of the document.
+        char cacheFile[512] = {};
+        if (!diskCache.empty())
+        {
+            SDL_snprintf(cacheFile, sizeof(cacheFile), "%s%016llx_%dx%d.rtex", diskCache.c_str(), (unsigned long long)document.hash, width,
+                         height);
+            assets::CookedTexture cached;
+            if (cached.OpenFile(cacheFile) && cached.GetFormat() == SDL_PIXELFORMAT_RGBA32)
+            {
+                pixels.width = cached.GetWidth();
+                pixels.height = cached.GetHeight();
+                pixels.data.resize(static_cast<size_t>(pixels.width) * pixels.height * 4);
+                for (int y = 0; y < pixels.height; y++)
+                    std::memcpy(pixels.data.data() + static_cast<size_t>(y) * pixels.width * 4, cached.GetPixels() + static_cast<size_t>(y) * cached.GetPitch(),
+                                static_cast<size_t>(pixels.width) * 4);
+                fromDisk = true;
+                return true;
+            }
+        }
+
+        SDL_IOStream *io = SDL_IOFromConstMem(document.data.data(), document.data.size());
+        SDL_Surface *surface = io ? IMG_LoadSizedSVG_IO(io, width, height) : nullptr;
+        SDL_CloseIO(io);
+        if (surface && surface->format != SDL_PIXELFORMAT_RGBA32)
+        {
+            SDL_Surface *converted = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+            SDL_DestroySurface(surface);
+            surface = converted;
+        }
+        if (!surface)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "SvgCache: couldn't rasterize %s at %dx%d: %s", document.path.c_str(), width, height, SDL_GetError());
+            return false;
+        }
+
+        pixels.width = surface->w;
+        pixels.height = surface->h;
+        pixels.data.resize(static_cast<size_t>(pixels.width) * pixels.height * 4);
+        Uint8 *destination = pixels.data.data();
+        for (int y = 0; y < surface->h; y++)
+        {
+            const Uint8 *row = static_cast<const Uint8 *>(surface->pixels) + static_cast<size_t>(y) * surface->pitch;
+            for (int x = 0; x < surface->w * 4; x += 4, destination += 4)
+            {
+                const Uint8 alpha = row[x + 3];
+                for (int j = 0; j < 3; ++j)
+                    destination[j] = Uint8(int(row[x + j]) * int(alpha) / 255);
+                destination[3] = alpha;
+            }
+        }
+        SDL_DestroySurface(surface);
+        fromDisk = false;
+
+        if (cacheFile[0] && !assets::CookedTexture::Write(cacheFile, pixels.width, pixels.height, pixels.data.data()))
+            SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "SvgCache: couldn't write %s: %s", cacheFile, SDL_GetError());
+        return true;
+    }
+
+    SDL_Texture *SvgCache::CreateTexture(const Pixels &pixels) const
+    {
+        RenderLock lock{queue};
+        SDL_Texture *texture = compact::CreateTexture(renderer, pixels.data.data(), pixels.width, pixels.height, pixels.width * 4);
+        if (texture)
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+        return texture;
+    }
+
+    void SvgCache::AddRaster(Document &document, int width, int height, const Pixels &pixels)
+    {
+        SDL_Texture *texture = CreateTexture(pixels);
+        if (!texture)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "SvgCache: couldn't create a texture for %s: %s", document.path.c_str(), SDL_GetError());
+            return;
+        }
+
+        // After an eviction the raster is remade on the spot, usually from the disk cache.
+        Document *source = &document;
+        const TextureId id = textures->Add(texture, "svg", [this, source, width, height]() -> SDL_Texture *
+                                           {
+                                               Pixels reloaded;
+                                               bool fromDisk = false;
+                                               return Rasterize(*source, width, height, reloaded, fromDisk) ? CreateTexture(reloaded) : nullptr; });
+        document.rasters.push_back({width, height, id, frame});
+        stats.rasters++;
+    }
+
+    int SDLCALL SvgCache::WorkerMain(void *userdata)
+    {
+        static_cast<SvgCache *>(userdata)->RunWorker();
+        return 0;
+    }
+
+    void SvgCache::RunWorker()
+    {
+        core::memory::tracking::SetThreadName("svg");
+
+        SDL_LockMutex(mutex);
+        while (!quit)
+        {
+            if (jobs.empty())
+            {
+                SDL_WaitCondition(wake, mutex);
+                continue;
+            }
+            const Job job = jobs.front();
+            jobs.pop_front();
+            SDL_UnlockMutex(mutex);
+
+            Result result{job.document, job.width, job.height, {}, false};
+            {
+                trace::Scope step{"rasterize svg"};
+                if (!Rasterize(*job.document, job.width, job.height, result.pixels, result.fromDisk))
+                    result.pixels.data.clear();
+            }
+
+            SDL_LockMutex(mutex);
+            results.push_back(std::move(result));
+            SDL_SignalCondition(rasterized);
+        }
+        SDL_UnlockMutex(mutex);
+    }
+
+} // namespace core::render
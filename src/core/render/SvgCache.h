@@ -0,0 +1,163 @@
+#ifndef CORE_RENDER_SVG_CACHE_H
+#define CORE_RENDER_SVG_CACHE_H
+
+#include <SDL3/SDL.h>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/render/TextureManager.h"
+
+namespace core::render
+{
+
+    class RenderQueue;
+
+    /**
+     * @brief Rasterizes SVG documents at the pixel size they are drawn at, shared by every scene.
+     *
+     * Get() returns a raster of exactly the requested size when there is one. Otherwise it keeps
+     * returning the closest existing raster, scaled by the draw, and once the requested size has
+     * stopped changing for SETTLE_MS (a window resize has settled) a worker thread rasterizes the
+     * new size, which Update() then uploads. Only the very first raster of a document is made on the
+     * calling thread, since there is nothing to draw in the meantime.
+     *
+     * Rasters are registered in the TextureManager under the "svg" owner, so they count against the
+     * budget and are re-rasterized after an eviction. With a disk cache, rasters are also stored as
+     * .rtex files keyed by the document hash and size, and later runs skip rasterization.
+     *
+     * Everything but the rasterization itself runs on the main thread.
+     */
+    class SvgCache
+    {
+    public:
+        /// How long a requested size must stay the same before it is rasterized.
+        static constexpr Uint64 SETTLE_MS = 150;
+        /// Rasters not drawn for this many frames are released, except the last one of each document.
+        static constexpr Uint64 UNUSED_FRAMES = 120;
+        /// Requests are clamped to this size on each axis.
+        static constexpr int MAX_SIZE = 4096;
+
+        struct Stats
+        {
+            size_t documents{0};
+            size_t rasters{0};
+            Uint64 rasterized{0}; ///< Rasters made from the document, on any thread.
+            Uint64 diskHits{0};   ///< Rasters read back from the disk cache instead.
+        };
+
+        SvgCache(SDL_Renderer *renderer, RenderQueue *queue, TextureManager *textures);
+        ~SvgCache();
+
+        /// Non-copyable
+        SvgCache(const SvgCache &) = delete;
+        SvgCache &operator=(const SvgCache &) = delete;
+
+        /**
+         * @brief Stores rasters in `directory` and looks them up there first; empty disables the disk cache.
+         * Set it before the first Get().
+         */
+        void SetDiskCache(const std::string &directory);
+
+        /**
+         * @brief Reads a document so that it can be drawn. Get() loads on demand, this only reports errors early.
+         * @return false if the file can't be read.
+         */
+        bool Load(const std::string &path);
+
+        /**
+         * @brief Loads a document and starts rasterizing it at `width` x `height` on the worker. A first
+         * Get() that finds no raster waits for this one instead of rasterizing on the calling thread.
+         * @return false if the file can't be read.
+         */
+        bool Prefetch(const std::string &path, int width, int height);
+
+        /**
+         * @brief The best raster of `path` for a `width` x `height` pixel area, marked as used this frame.
+         * @return nullptr if the document can't be loaded or rasterized.
+         */
+        SDL_Texture *Get(const std::string &path, int width, int height);
+
+        /**
+         * @brief Uploads the rasters finished by the worker and starts the settled requests. Once per frame,
+         * before the scenes render.
+         */
+        void Update();
+
+        const Stats &GetStats() const { return stats; }
+
+    private:
+        /// Premultiplied RGBA32, tightly packed.
+        struct Pixels
+        {
+            int width{0};
+            int height{0};
+            std::vector<Uint8> data;
+        };
+
+        struct Raster
+        {
+            int width; ///< Requested size; the pixels keep the document's aspect ratio and may be smaller.
+            int height;
+            TextureId texture;
+            Uint64 lastUsedFrame;
+        };
+
+        struct Document
+        {
+            std::string path;
+            std::vector<Uint8> data; ///< Immutable once loaded, read by the worker.
+            Uint64 hash{0};
+            std::vector<Raster> rasters;
+            int pendingWidth{0}; ///< Size asked for without an exact raster, 0 if none.
+            int pendingHeight{0};
+            Uint64 pendingSince{0};
+            bool queued{false};
+        };
+
+        struct Job
+        {
+            Document *document;
+            int width;
+            int height;
+        };
+
+        struct Result
+        {
+            Document *document;
+            int width;
+            int height;
+            Pixels pixels;
+            bool fromDisk;
+        };
+
+        SDL_Renderer *renderer;
+        RenderQueue *queue;
+        TextureManager *textures;
+        std::string diskCache;
+        std::unordered_map<std::string, Document> documents; // Nodes are stable, jobs point into them.
+        Uint64 frame{0};
+        Stats stats;
+
+        SDL_Thread *worker{nullptr};
+        SDL_Mutex *mutex{nullptr};
+        SDL_Condition *wake{nullptr};
+        SDL_Condition *rasterized{nullptr}; ///< Signalled with each new result.
+        std::deque<Job> jobs;
+        std::vector<Result> results;
+        bool quit{false};
+
+        Document *Find(const std::string &path);
+        bool Rasterize(const Document &document, int width, int height, Pixels &pixels, bool &fromDisk) const;
+        SDL_Texture *CreateTexture(const Pixels &pixels) const;
+        void AddRaster(Document &document, int width, int height, const Pixels &pixels);
+        void UploadResults(bool wait);
+
+        static int SDLCALL WorkerMain(void *userdata);
+        void RunWorker();
+    };
+
+} // namespace core::render
+
+#endif // CORE_RENDER_SVG_CACHE_H
@@ -0,0 +1,576 @@
+#include "core/render/TextureManager.h"
+#include "core/render/CompactTextures.h"
+#include "core/render/RenderQueue.h"
+#include "core/assets/AssetPack.h"
+#include "core/assets/CookedTexture.h"
+#include "core/memory/AllocationTracker.h"
+#include "core/trace/StartupTrace.h"
+
+#include <SDL3_image/SDL_image.h>
+#include <algorithm>
+#include <cstring>
+
+namespace core::render
+{
+
+    static size_t EstimateBytes(int width, int height, SDL_PixelFormat format)
+    {
+        return static_cast<size_t>(width) * height * SDL_BYTESPERPIXEL(format);
+    }
+
+    /// SDL_CreateTextureFromSurface(), in a 16-bit format when compact textures are enabled and the image allows it.
+    static SDL_Texture *CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *surface)
+    {
+        if (!compact::IsEnabled())
+            return SDL_CreateTextureFromSurface(renderer, surface);
+
+        SDL_Surface *rgba = surface->format == SDL_PIXELFORMAT_RGBA32 ? surface : SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+        if (!rgba)
+            return nullptr;
+        SDL_Texture *texture = compact::CreateTexture(renderer, static_cast<const Uint8 *>(rgba->pixels), rgba->w, rgba->h, rgba->pitch);
+        if (texture)
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        if (rgba != surface)
+            SDL_DestroySurface(rgba);
+        return texture;
+    }
+
+    static void DestroyTexture(RenderQueue *queue, SDL_Texture *texture)
+    {
+        if (queue)
+            queue->DestroyTexture(texture);
+        else
+            SDL_DestroyTexture(texture);
+    }
+
+    TextureManager::TextureManager(SDL_Renderer *renderer, RenderQueue *queue, size_t budgetBytes)
+        : renderer(renderer), queue(queue), budget(budgetBytes)
+    {
+    }
+
+    /// "dir/name.png" -> "dir/name@2x.png"
+    static std::string VariantPath(const std::string &path, int scale)
+    {
+        size_t dot = path.rfind('.');
+        const size_t slash = path.find_last_of("/\\");
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+            dot = path.size();
+        return path.substr(0, dot) + "@" + std::to_string(scale) + "x" + path.substr(dot);
+    }
+
+    static bool AssetExists(const std::string &path)
+    {
+        return assets::FindAsset(path).data() != nullptr || SDL_GetPathInfo(path.c_str(), nullptr);
+    }
+
+    TextureManager::~TextureManager()
+    {
+        if (worker)
+        {
+            SDL_LockMutex(mutex);
+            quit = true;
+            SDL_SignalCondition(wake);
+            SDL_UnlockMutex(mutex);
+            SDL_WaitThread(worker, nullptr);
+        }
+        for (DecodedVariant &variant : decoded)
+            SDL_DestroySurface(variant.surface);
+        for (auto &[path, result] : prefetched)
+            SDL_DestroySurface(result.surface);
+        SDL_DestroyCondition(prefetchDone);
+        SDL_DestroyCondition(wake);
+        SDL_DestroyMutex(mutex);
+
+        for (auto &[id, entry] : entries)
+        {
+            if (entry.texture)
+                DestroyTexture(queue, entry.texture);
+        }
+    }
+
+    TextureManager::Loader TextureManager::FileLoader(const std::string &path)
+    {
+        return [this, path]() -> SDL_Texture *
+        {
+            assets::CookedTexture cooked;
+            if (cooked.Open(path))
+            {
+                RenderLock lock{queue};
+                if (SDL_Texture *texture = cooked.CreateTexture(renderer))
+                    return texture;
+                SDL_LogError(SDL_LOG_CATEGORY_RENDER, "TextureManager: couldn't create a texture for %s: %s", path.c_str(), SDL_GetError());
+                return nullptr;
+            }
+
+            SDL_IOStream *io = assets::OpenAsset(path);
+            SDL_Surface *surface = io ? IMG_Load_IO(io, true) : nullptr;
+            if (!surface)
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_RENDER, "TextureManager: couldn't load %s: %s", path.c_str(), SDL_GetError());
+                return nullptr;
+            }
+
+            SDL_Texture *texture;
+            {
+                RenderLock lock{queue};
+                texture = CreateTextureFromSurface(renderer, surface);
+            }
+            SDL_DestroySurface(surface);
+            if (!texture)
+                SDL_LogError(SDL_LOG_CATEGORY_RENDER, "TextureManager: couldn't create a texture for %s: %s", path.c_str(), SDL_GetError());
+            return texture;
+        };
+    }
+
+    TextureId TextureManager::Load(const std::string &path, const std::string &owner)
+    {
+        Loader loader = FileLoader(path);
+        SDL_Texture *texture = TakePrefetched(path);
+        if (!texture)
+            texture = loader();
+        if (!texture)
+            return INVALID_TEXTURE;
+        return Add(texture, owner, std::move(loader));
+    }
+
+    TextureId TextureManager::LoadVariants(const std::string &path, const std::string &owner)
+    {
+        const TextureId id = Load(path, owner);
+        if (id == INVALID_TEXTURE)
+            return INVALID_TEXTURE;
+
+        VariantSet set{owner, {}};
+        for (int scale : VARIANT_SCALES)
+        {
+            std::string variantPath = VariantPath(path, scale);
+            if (AssetExists(variantPath))
+                set.variants.push_back({scale, std::move(variantPath)});
+        }
+        if (!set.variants.empty())
+            variantSets.emplace(id, std::move(set));
+        return id;
+    }
+
+    void TextureManager::Prefetch(const std::string &path)
+    {
+        if (!StartWorker())
+            return;
+
+        SDL_LockMutex(mutex);
+        if (prefetched.emplace(path, Prefetched{}).second)
+        {
+            decodeJobs.push_back({INVALID_TEXTURE, 1, path});
+            SDL_SignalCondition(wake);
+        }
+        SDL_UnlockMutex(mutex);
+    }
+
+    SDL_Texture *TextureManager::TakePrefetched(const std::string &path)
+    {
+        if (!worker)
+            return nullptr;
+
+        SDL_LockMutex(mutex);
+        auto it = prefetched.find(path);
+        if (it == prefetched.end())
+        {
+            SDL_UnlockMutex(mutex);
+            return nullptr;
+        }
+        while (!it->second.done)
+        {
+            SDL_WaitCondition(prefetchDone, mutex);
+            it = prefetched.find(path);
+        }
+        const Prefetched result = it->second;
+        prefetched.erase(it);
+        SDL_UnlockMutex(mutex);
+
+        // A failed decode falls back to the loader, which reports the error.
+        if (!result.surface)
+            return nullptr;
+
+        SDL_Texture *texture;
+        {
+            RenderLock lock{queue};
+            texture = CreateTextureFromSurface(renderer, result.surface);
+            if (texture && result.premultiplied)
+                SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+        }
+        SDL_DestroySurface(result.surface);
+        return texture;
+    }
+
+    TextureId TextureManager::Add(SDL_Texture *texture, const std::string &owner, Loader reload)
+    {
+        if (!texture)
+            return INVALID_TEXTURE;
+
+        const TextureId id = nextId++;
+        Entry &entry = entries[id];
+        entry.texture = nullptr;
+        entry.owner = owner;
+        entry.reload = std::move(reload);
+        entry.lastUsedFrame = frame;
+        stats.textures++;
+
+        if (budget)
+            EvictDownTo(budget - std::min(budget, EstimateBytes(texture->w, texture->h, texture->format)));
+        MakeResident(entry, texture);
+        return id;
+    }
+
+    SDL_Texture *TextureManager::Get(TextureId id)
+    {
+        auto it = entries.find(id);
+        if (it == entries.end())
+            return nullptr;
+
+        Entry &entry = it->second;
+        entry.lastUsedFrame = frame;
+        if (!entry.texture && entry.reload)
+        {
+            // Make room for it first; the size is the one it had before the eviction.
+            if (budget)
+                EvictDownTo(budget - std::min(budget, EstimateBytes(entry.width, entry.height, entry.format)));
+            if (SDL_Texture *texture = entry.reload())
+            {
+                MakeResident(entry, texture);
+                stats.reloads++;
+            }
+        }
+        return entry.texture;
+    }
+
+    SDL_Texture *TextureManager::Get(TextureId id, float width, float height)
+    {
+        auto setIt = variantSets.find(id);
+        auto baseIt = entries.find(id);
+        if (setIt == variantSets.end() || baseIt == entries.end() || baseIt->second.width <= 0 || baseIt->second.height <= 0)
+            return Get(id);
+
+        // A little magnification is invisible and much cheaper than the next variant.
+        constexpr float SLACK = 1.1f;
+        const float needed = std::max(width / baseIt->second.width, height / baseIt->second.height) / SLACK;
+        if (needed <= 1.0f)
+            return Get(id);
+
+        VariantSet &set = setIt->second;
+        Variant *wanted = &set.variants.back();
+        for (Variant &variant : set.variants)
+        {
+            if (variant.scale >= needed)
+            {
+                wanted = &variant;
+                break;
+            }
+        }
+        if (wanted->texture != INVALID_TEXTURE)
+            return Get(wanted->texture);
+
+        RequestVariant(id, set, *wanted);
+
+        // Meanwhile, the loaded variant closest to the wanted one, the larger on a tie.
+        TextureId fallback = id;
+        int fallbackScale = 1;
+        for (const Variant &variant : set.variants)
+        {
+            if (variant.texture != INVALID_TEXTURE && std::abs(variant.scale - wanted->scale) <= std::abs(fallbackScale - wanted->scale))
+            {
+                fallback = variant.texture;
+                fallbackScale = variant.scale;
+            }
+        }
+        return Get(fallback);
+    }
+
+    void TextureManager::Release(TextureId id)
+    {
+        auto setIt = variantSets.find(id);
+        if (setIt != variantSets.end())
+        {
+            // Variants still being decoded are dropped by UploadVariants().
+            for (const Variant &variant : setIt->second.variants)
+            {
+                if (variant.texture != INVALID_TEXTURE)
+                    Release(variant.texture);
+            }
+            variantSets.erase(setIt);
+        }
+
+        auto it = entries.find(id);
+        if (it == entries.end())
+            return;
+
+        Evict(it->second);
+        entries.erase(it);
+        stats.textures--;
+    }
+
+    void TextureManager::EndFrame()
+    {
+        UploadVariants();
+        ReleaseUnusedVariants();
+        frame++;
+        if (budget && stats.bytes > budget)
+            EvictDownTo(budget);
+    }
+
+    void TextureManager::Trim()
+    {
+        for (auto &[id, entry] : entries)
+        {
+            if (entry.texture && entry.reload && entry.lastUsedFrame < frame)
+            {
+                Evict(entry);
+                stats.evictions++;
+            }
+        }
+    }
+
+    void TextureManager::SetBudget(size_t bytes)
+    {
+        budget = bytes;
+        overBudgetLogged = false;
+        if (budget && stats.bytes > budget)
+            EvictDownTo(budget);
+    }
+
+    void TextureManager::GetOwnerStats(memory::FrameVector<OwnerStats> &owners) const
+    {
+        owners.clear();
+        for (const auto &[id, entry] : entries)
+        {
+            auto it = std::find_if(owners.begin(), owners.end(), [&](const OwnerStats &owner)
+                                   { return owner.owner == entry.owner; });
+            if (it == owners.end())
+            {
+                owners.push_back({entry.owner});
+                it = owners.end() - 1;
+            }
+            it->textures++;
+            if (entry.texture)
+            {
+                it->resident++;
+                it->bytes += EstimateBytes(entry.width, entry.height, entry.format);
+            }
+        }
+        std::sort(owners.begin(), owners.end(), [](const OwnerStats &a, const OwnerStats &b)
+                  { return a.bytes > b.bytes; });
+    }
+
+    void TextureManager::MakeResident(Entry &entry, SDL_Texture *texture)
+    {
+        entry.texture = texture;
+        entry.width = texture->w;
+        entry.height = texture->h;
+        entry.format = texture->format;
+        stats.resident++;
+        stats.bytes += EstimateBytes(entry.width, entry.height, entry.format);
+        stats.savedBytes += EstimateBytes(entry.width, entry.height, SDL_PIXELFORMAT_RGBA32) - EstimateBytes(entry.width, entry.height, entry.format);
+        stats.peakBytes = std::max(stats.peakBytes, stats.bytes);
+    }
+
+    void TextureManager::Evict(Entry &entry)
+    {
+        if (!entry.texture)
+            return;
+
+        DestroyTexture(queue, entry.texture);
+        entry.texture = nullptr;
+        stats.resident--;
+        stats.bytes -= EstimateBytes(entry.width, entry.height, entry.format);
+        stats.savedBytes -= EstimateBytes(entry.width, entry.height, SDL_PIXELFORMAT_RGBA32) - EstimateBytes(entry.width, entry.height, entry.format);
+    }
+
+    void TextureManager::EvictDownTo(size_t bytes)
+    {
+        while (stats.bytes > bytes)
+        {
+            // Least recently drawn first. Textures drawn this frame are kept, they would only be reloaded by the next one.
+            Entry *victim = nullptr;
+            for (auto &[id, entry] : entries)
+            {
+                if (entry.texture && entry.reload && entry.lastUsedFrame < frame && (!victim || entry.lastUsedFrame < victim->lastUsedFrame))
+                    victim = &entry;
+            }
+
+            if (!victim)
+            {
+                if (!overBudgetLogged)
+                {
+                    SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "TextureManager: can't get below %zu bytes (%zu resident, budget %zu), nothing left to evict",
+                                bytes, stats.bytes, budget);
+                    overBudgetLogged = true;
+                }
+                return;
+            }
+
+            Evict(*victim);
+            stats.evictions++;
+        }
+        overBudgetLogged = false;
+    }
+
+    bool TextureManager::StartWorker()
+    {
+        if (!worker && !mutex)
+        {
+            mutex = SDL_CreateMutex();
+            wake = SDL_CreateCondition();
+            prefetchDone = SDL_CreateCondition();
+            worker = mutex && wake && prefetchDone ? SDL_CreateThread(WorkerMain, "textures", this) : nullptr;
+            if (!worker)
+                SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "TextureManager: no worker thread, images are decoded on the main thread: %s", SDL_GetError());
+        }
+        return worker != nullptr;
+    }
+
+    void TextureManager::RequestVariant(TextureId base, VariantSet &set, Variant &variant)
+    {
+        if (variant.requested)
+            return;
+        variant.requested = true;
+
+        if (!StartWorker())
+        {
+            Loader loader = FileLoader(variant.path);
+            variant.texture = Add(loader(), set.owner, loader);
+            return;
+        }
+
+        SDL_LockMutex(mutex);
+        decodeJobs.push_back({base, variant.scale, variant.path});
+        SDL_SignalCondition(wake);
+        SDL_UnlockMutex(mutex);
+    }
+
+    void TextureManager::UploadVariants()
+    {
+        if (!worker)
+            return;
+
+        std::vector<DecodedVariant> finished;
+        SDL_LockMutex(mutex);
+        finished.swap(decoded);
+        SDL_UnlockMutex(mutex);
+
+        for (DecodedVariant &result : finished)
+        {
+            auto setIt = variantSets.find(result.base);
+            if (setIt == variantSets.end())
+            {
+                SDL_DestroySurface(result.surface); // Released while it was decoding.
+                continue;
+            }
+
+            std::vector<Variant> &variants = setIt->second.variants;
+            auto variant = std::find_if(variants.begin(), variants.end(), [&](const Variant &variant)
+                                        { return variant.scale == result.scale; });
+            SDL_Texture *texture = nullptr;
+            if (result.surface)
+            {
+                RenderLock lock{queue};
+                texture = CreateTextureFromSurface(renderer, result.surface);
+                if (texture && result.premultiplied)
+                    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+            }
+            SDL_DestroySurface(result.surface);
+
+            if (!texture)
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_RENDER, "TextureManager: couldn't load variant %s: %s", variant->path.c_str(), SDL_GetError());
+                continue;
+            }
+            variant->texture = Add(texture, setIt->second.owner, FileLoader(variant->path));
+            stats.variantLoads++;
+        }
+    }
+
+    void TextureManager::ReleaseUnusedVariants()
+    {
+        for (auto &[base, set] : variantSets)
+        {
+            for (Variant &variant : set.variants)
+            {
+                auto it = entries.find(variant.texture);
+                if (it != entries.end() && frame - it->second.lastUsedFrame > UNUSED_VARIANT_FRAMES)
+                {
+                    Release(variant.texture);
+                    variant.texture = INVALID_TEXTURE;
+                    variant.requested = false;
+                }
+            }
+        }
+    }
+
+    SDL_Surface *TextureManager::Decode(const std::string &path, bool &premultiplied)
+    {
+        // A cooked variant only needs copying out of the pack; the copy is what lets the upload happen later.
+        assets::CookedTexture cooked;
+        if (cooked.Open(path))
+        {
+            SDL_Surface *surface = SDL_CreateSurface(cooked.GetWidth(), cooked.GetHeight(), cooked.GetFormat());
+            if (surface)
+            {
+                const size_t rowSize = static_cast<size_t>(cooked.GetWidth()) * SDL_BYTESPERPIXEL(cooked.GetFormat());
+                for (int y = 0; y < cooked.GetHeight(); y++)
+                    std::memcpy(static_cast<Uint8 *>(surface->pixels) + static_cast<size_t>(y) * surface->pitch,
+                                cooked.GetPixels() + static_cast<size_t>(y) * cooked.GetPitch(), rowSize);
+            }
+            premultiplied = true;
+            return surface;
+        }
+
+        SDL_IOStream *io = assets::OpenAsset(path);
+        premultiplied = false;
+        return io ? IMG_Load_IO(io, true) : nullptr;
+    }
+
+    int SDLCALL TextureManager::WorkerMain(void *userdata)
+    {
+        static_cast<TextureManager *>(userdata)->RunWorker();
+        return 0;
+    }
+
+    void TextureManager::RunWorker()
+    {
+        core::memory::tracking::SetThreadName("textures");
+
+        SDL_LockMutex(mutex);
+        while (!quit)
+        {
+            if (decodeJobs.empty())
+            {
+                SDL_WaitCondition(wake, mutex);
+                continue;
+            }
+            const DecodeJob job = decodeJobs.front();
+            decodeJobs.pop_front();
+            SDL_UnlockMutex(mutex);
+
+            if (job.base == INVALID_TEXTURE)
+            {
+                SDL_Surface *surface;
+                bool premultiplied = false;
+                {
+                    trace::Scope step{"prefetch texture"};
+                    surface = Decode(job.path, premultiplied);
+                }
+
+                SDL_LockMutex(mutex);
+                prefetched[job.path] = {surface, premultiplied, true};
+                SDL_BroadcastCondition(prefetchDone);
+                continue;
+            }
+
+            bool premultiplied = false;
+            SDL_Surface *surface = Decode(job.path, premultiplied);
+
+            SDL_LockMutex(mutex);
+            decoded.push_back({job.base, job.scale, surface, premultiplied});
+        }
+        SDL_UnlockMutex(mutex);
+    }
+
+} // namespace core::render
@@ -0,0 +1,240 @@
+#ifndef CORE_RENDER_TEXTURE_MANAGER_H
+#define CORE_RENDER_TEXTURE_MANAGER_H
+
+#include <SDL3/SDL.h>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "core/memory/FrameArena.h"
+
+namespace core::render
+{
+
+    class RenderQueue;
+
+    using TextureId = Uint32;
+    inline constexpr TextureId INVALID_TEXTURE = 0;
+
+    /**
+     * @brief Owns the long-lived textures of the game and keeps their memory under a budget.
+     *
+     * Every texture is registered with an owner (a scene name, "ui", ...) and accounted by size
+     * and format. Textures registered with a loader can be evicted: when the resident total goes
+     * over the budget, the least recently drawn ones are destroyed and transparently recreated by
+     * the next Get(). Textures without a loader, or drawn in the current frame, are never evicted.
+     *
+     * Scenes keep TextureId handles and resolve them with Get() right before recording a draw.
+     * Eviction destroys through the RenderQueue, so commands already recorded stay valid.
+     *
+     * Images shipped in several resolutions ("ball.png", "ball@2x.png", "ball@4x.png") are loaded
+     * with LoadVariants() and drawn with the sized Get(), which picks the smallest variant covering
+     * the on-screen size. Larger variants are decoded on a background thread and swapped in by
+     * EndFrame(); variants no longer picked are released.
+     */
+    class TextureManager
+    {
+    public:
+        /// Recreates an evicted texture; returns nullptr on failure.
+        using Loader = std::function<SDL_Texture *()>;
+
+        struct Stats
+        {
+            size_t textures{0};  ///< Registered textures, resident or evicted.
+            size_t resident{0};  ///< Textures currently in memory.
+            size_t bytes{0};     ///< Estimated memory of the resident textures.
+            size_t peakBytes{0};
+            size_t savedBytes{0}; ///< Resident bytes saved by formats smaller than RGBA32, see CompactTextures.h.
+            Uint64 evictions{0};
+            Uint64 reloads{0};
+            Uint64 variantLoads{0}; ///< Variants decoded in the background.
+        };
+
+        struct OwnerStats
+        {
+            std::string_view owner; ///< Valid until the next Load(), Add() or Release().
+            size_t textures{0};
+            size_t resident{0};
+            size_t bytes{0};
+        };
+
+        /**
+         * @param queue Used to lock the renderer while loading and to defer destruction; may be null.
+         * @param budgetBytes Resident memory above which textures are evicted; 0 disables the budget.
+         */
+        TextureManager(SDL_Renderer *renderer, RenderQueue *queue, size_t budgetBytes = 0);
+        ~TextureManager();
+
+        /// Variant scales looked up by LoadVariants(), as "@<scale>x" before the extension.
+        static constexpr int VARIANT_SCALES[] = {2, 4};
+        /// A variant not picked for this many frames is released; the @1x image always stays.
+        static constexpr Uint64 UNUSED_VARIANT_FRAMES = 120;
+
+        /// Non-copyable
+        TextureManager(const TextureManager &) = delete;
+        TextureManager &operator=(const TextureManager &) = delete;
+
+        /**
+         * @brief Loads an image file with SDL_image. The texture is reloaded from the file after an eviction.
+         * @return The handle, or INVALID_TEXTURE on failure.
+         */
+        TextureId Load(const std::string &path, const std::string &owner);
+
+        /**
+         * @brief Loads `path` as the @1x variant and looks up its @2x and @4x siblings, which are only
+         * loaded once the sized Get() needs them.
+         * @return The handle, or INVALID_TEXTURE if `path` itself can't be loaded.
+         */
+        TextureId LoadVariants(const std::string &path, const std::string &owner);
+
+        /**
+         * @brief Starts decoding `path` on the worker thread; the next Load() or LoadVariants() of the
+         * same path uses the result, waiting for it if needed. For startup, where the decode can run
+         * while the rest of the app initializes.
+         */
+        void Prefetch(const std::string &path);
+
+        /**
+         * @brief Takes ownership of an existing texture.
+         * @param reload Recreates the texture after an eviction; without it the texture stays resident.
+         * @return The handle, or INVALID_TEXTURE if `texture` is null.
+         */
+        TextureId Add(SDL_Texture *texture, const std::string &owner, Loader reload = {});
+
+        /**
+         * @brief Returns the texture to draw, reloading it if it was evicted, and marks it as used this frame.
+         * @return nullptr for unknown handles or when the reload fails.
+         */
+        SDL_Texture *Get(TextureId id);
+
+        /**
+         * @brief Returns the variant best suited to a `width` x `height` pixel area, e.g. the rect from
+         * core::utils::image::GetImageRect(). While that variant is being decoded, the closest loaded one
+         * is returned instead, so a resize or a display density change never waits on a decode.
+         * Same as Get(id) for textures loaded without variants.
+         */
+        SDL_Texture *Get(TextureId id, float width, float height);
+
+        /**
+         * @brief Destroys the texture once the commands recorded so far have been replayed.
+         */
+        void Release(TextureId id);
+
+        /**
+         * @brief Starts a new frame: adds the variants decoded in the background, releases the unused
+         * ones and evicts down to the budget if needed.
+         */
+        void EndFrame();
+
+        /**
+         * @brief Evicts every reloadable texture not drawn this frame, e.g. on SDL_EVENT_LOW_MEMORY.
+         */
+        void Trim();
+
+        void SetBudget(size_t bytes);
+        size_t GetBudget() const { return budget; }
+
+        /**
+         * @brief Changes the queue used for locking and destruction. Existing textures are kept.
+         */
+        void SetQueue(RenderQueue *queue) { this->queue = queue; }
+
+        const Stats &GetStats() const { return stats; }
+
+        /**
+         * @brief Residency per owner, sorted by resident bytes, largest first.
+         * @param owners Replaced with the result; a frame vector, since the stats overlay asks every frame.
+         */
+        void GetOwnerStats(memory::FrameVector<OwnerStats> &owners) const;
+
+    private:
+        struct Entry
+        {
+            SDL_Texture *texture;
+            std::string owner;
+            Loader reload;
+            int width;
+            int height;
+            SDL_PixelFormat format;
+            Uint64 lastUsedFrame;
+        };
+
+        struct Variant
+        {
+            int scale;
+            std::string path;
+            TextureId texture{INVALID_TEXTURE}; ///< Not loaded yet, or released.
+            bool requested{false}; ///< Stays set after a failed load, so that it isn't retried every frame.
+        };
+
+        /// The larger variants of a texture, keyed by the handle of its @1x image.
+        struct VariantSet
+        {
+            std::string owner;
+            std::vector<Variant> variants; ///< By increasing scale.
+        };
+
+        struct DecodeJob
+        {
+            TextureId base;
+            int scale;
+            std::string path;
+        };
+
+        /// A variant decoded by the worker, waiting for EndFrame() to upload it.
+        struct DecodedVariant
+        {
+            TextureId base;
+            int scale;
+            SDL_Surface *surface;
+            bool premultiplied;
+        };
+
+        /// A Prefetch() result, waiting for Load().
+        struct Prefetched
+        {
+            SDL_Surface *surface{nullptr};
+            bool premultiplied{false};
+            bool done{false};
+        };
+
+        SDL_Renderer *renderer;
+        RenderQueue *queue;
+        size_t budget;
+        std::unordered_map<TextureId, Entry> entries;
+        std::unordered_map<TextureId, VariantSet> variantSets;
+        TextureId nextId{1};
+        Uint64 frame{0};
+        Stats stats;
+        bool overBudgetLogged{false};
+
+        SDL_Thread *worker{nullptr};
+        SDL_Mutex *mutex{nullptr};
+        SDL_Condition *wake{nullptr};
+        SDL_Condition *prefetchDone{nullptr};
+        std::deque<DecodeJob> decodeJobs; ///< Prefetches have no base texture.
+        std::vector<DecodedVariant> decoded;
+        std::unordered_map<std::string, Prefetched> prefetched;
+        bool quit{false};
+
+        Loader FileLoader(const std::string &path);
+        bool StartWorker();
+        SDL_Texture *TakePrefetched(const std::string &path);
+        void RequestVariant(TextureId base, VariantSet &set, Variant &variant);
+        void UploadVariants();
+        void ReleaseUnusedVariants();
+        static SDL_Surface *Decode(const std::string &path, bool &premultiplied);
+        static int SDLCALL WorkerMain(void *userdata);
+        void RunWorker();
+
+        void MakeResident(Entry &entry, SDL_Texture *texture);
+        void Evict(Entry &entry);
+        void EvictDownTo(size_t bytes);
+    };
+
+} // namespace core::render
+
+#endif // CORE_RENDER_TEXTURE_MANAGER_H
@@ -1,4 +1,6 @@
 #include "core/scene/Manager.h"
+#include "core/memory/AllocationTracker.h"
+#include "core/trace/StartupTrace.h"
 
 namespace core::scene
 {
@@ -12,6 +14,7 @@ namespace core::scene
     bool Manager::RegisterAndInitScene(std::unique_ptr<Scene> scene)
     {
         const std::string &name = scene->GetName();
+        core::memory::tracking::PhaseScope phase{core::memory::tracking::Phase::SCENE_CHANGE};
 
         if (!scene->Init())
             return false;
@@ -22,6 +25,7 @@ namespace core::scene
 
     void Manager::RemoveScene(const std::string &name)
     {
+        core::memory::tracking::PhaseScope phase{core::memory::tracking::Phase::SCENE_CHANGE};
         auto it = scenes.find(name);
         if (it != scenes.end())
         {
@@ -30,8 +34,19 @@ namespace core::scene
                 currentScene->OnExit();
                 currentScene = nullptr;
             }
-            it->second->CleanUp();
+            std::unique_ptr<Scene> scene = std::move(it->second);
             scenes.erase(it);
+            if (releaseQueue)
+            {
+                releaseQueue->Push([scene = std::move(scene)]() mutable
+                                   {
+                                       scene->CleanUp();
+                                       scene.reset(); });
+            }
+            else
+            {
+                scene->CleanUp();
+            }
         }
     }
 
@@ -41,6 +56,7 @@ namespace core::scene
         if (it == scenes.end())
             return false;
 
+        core::memory::tracking::PhaseScope phase{core::memory::tracking::Phase::SCENE_CHANGE};
         if (currentScene)
         {
             currentScene->OnExit();
@@ -56,6 +72,8 @@ namespace core::scene
     {
         for (auto &[name, scene] : scenes)
         {
+            const std::string stepName = "init " + name;
+            trace::Scope step{stepName.c_str()};
             if (!scene->Init())
             {
                 return false;
@@ -64,9 +82,18 @@ namespace core::scene
         return true;
     }
 
-    std::string Manager::GetCurrentSceneName() const
+    void Manager::PrefetchScenes()
+    {
+        for (auto &[name, scene] : scenes)
+        {
+            scene->Prefetch();
+        }
+    }
+
+    const std::string &Manager::GetCurrentSceneName() const
     {
-        return currentScene ? currentScene->GetName() : "";
+        static const std::string none;
+        return currentScene ? currentScene->GetName() : none;
     }
 
     SDL_AppResult Manager::HandleEvent(SDL_Event *event)
@@ -5,6 +5,7 @@
 #include <memory>
 #include <string>
 #include "Scene.h"
+#include "core/memory/DeferredRelease.h"
 
 namespace core
 {
@@ -20,6 +21,7 @@ namespace core
         private:
             std::unordered_map<std::string, std::unique_ptr<Scene>> scenes;
             Scene *currentScene{nullptr};
+            memory::DeferredReleaseQueue *releaseQueue{nullptr};
 
         public:
             Manager() = default;
@@ -43,9 +45,16 @@ namespace core
              */
             bool RegisterAndInitScene(std::unique_ptr<Scene> scene);
 
+            /**
+             * @brief Makes RemoveScene() hand the scene's cleanup to `queue` instead of running it on the spot.
+             * @param queue Must outlive the manager's use of it; nullptr cleans up immediately.
+             */
+            void SetReleaseQueue(memory::DeferredReleaseQueue *queue) { releaseQueue = queue; }
+
             /**
              * @brief Removes a previously registered scene.
-             * If the scene is currently active, it will be exited and deactivated.
+             * If the scene is currently active, it will be exited and deactivated. Its CleanUp() and
+             * destruction go through the release queue when one is set.
              * @param name Name of the scene to remove.
              */
             void RemoveScene(const std::string &name);
@@ -65,11 +74,16 @@ namespace core
              */
             bool InitScenes();
 
+            /**
+             * @brief Calls Prefetch() on every registered scene.
+             */
+            void PrefetchScenes();
+
             /**
              * @brief Returns the name of the currently active scene.
              * @return Scene name, or empty string if none is active.
              */
-            std::string GetCurrentSceneName() const;
+            const std::string &GetCurrentSceneName() const;
 
             /**
              * @brief Passes the SDL event to the current scene.
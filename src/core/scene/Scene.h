@@ -19,6 +19,52 @@ namespace core
             const AppContext *app{nullptr}; ///< Application context (read-only).
             std::string sceneName;          ///< Identifier name of the scene.
 
+            /// A sound still playing when its scene goes away is unloaded after at most this long anyway.
+            static constexpr Uint64 SOUND_RELEASE_TIMEOUT_MS = 2000;
+            /// Crossfade between the music of a scene and whatever plays next.
+            static constexpr float MUSIC_FADE_SECONDS = 1.0f;
+
+            /**
+             * @brief Unloads `sound` through the release queue once it has stopped playing, and clears the handle.
+             * Unloads immediately without a queue; does nothing for INVALID_SOUND.
+             */
+            void ReleaseSound(audio::SoundId &sound) const
+            {
+                if (sound == audio::INVALID_SOUND)
+                    return;
+                audio::SfxMixer *sfx = app->sfx;
+                const audio::SoundId id = sound;
+                sound = audio::INVALID_SOUND;
+                if (!app->releases)
+                {
+                    sfx->Unload(id);
+                    return;
+                }
+                const Uint64 deadline = SDL_GetTicks() + SOUND_RELEASE_TIMEOUT_MS;
+                app->releases->Push([sfx, id]
+                                    { sfx->Unload(id); },
+                                    [sfx, id, deadline]
+                                    { return !sfx->IsPlaying(id) || SDL_GetTicks() >= deadline; });
+            }
+
+            /**
+             * @brief Releases `texture` through the release queue and clears the handle.
+             * Releases immediately without a queue; does nothing for INVALID_TEXTURE.
+             */
+            void ReleaseTexture(render::TextureId &texture) const
+            {
+                if (texture == render::INVALID_TEXTURE)
+                    return;
+                render::TextureManager *textures = app->textures;
+                const render::TextureId id = texture;
+                texture = render::INVALID_TEXTURE;
+                if (app->releases)
+                    app->releases->Push([textures, id]
+                                        { textures->Release(id); });
+                else
+                    textures->Release(id);
+            }
+
         public:
             /**
              * @brief Constructor that injects the application context and assigns a name to the scene.
@@ -42,7 +88,7 @@ namespace core
              * @brief Returns the scene's name.
              * @return The scene name.
              */
-            std::string GetName() const { return sceneName; }
+            const std::string &GetName() const { return sceneName; }
 
             // Scene lifecycle methods
 
@@ -52,6 +98,12 @@ namespace core
              */
             virtual bool Init() = 0;
 
+            /**
+             * @brief Starts loading what Init() needs in the background, e.g. with TextureManager::Prefetch().
+             * Called at startup for every registered scene before any Init(); optional.
+             */
+            virtual void Prefetch() {}
+
             /**
              * @brief Called when the scene is fully initialized.
              * Ideal for logic that depends on all resources being ready.
@@ -91,6 +143,7 @@ namespace core
 
             /**
              * @brief Renders the scene.
+             * The frame is presented by the main loop afterwards; scenes must not call SDL_RenderPresent.
              */
             virtual void Render() = 0;
         };
@@ -0,0 +1,114 @@
+#include "core/scene/SpriteLayer.h"
+
+#include <cmath>
+
+namespace core::scene
+{
+
+    /// Position of a pivot within a w x h rect, relative to its top-left corner.
+    static void PivotOffset(utils::image::Pivot pivot, float w, float h, float &x, float &y)
+    {
+        using utils::image::Pivot;
+        switch (pivot)
+        {
+        case Pivot::TopLeft:
+        case Pivot::CenterLeft:
+        case Pivot::BottomLeft:
+            x = 0.0f;
+            break;
+        case Pivot::TopCenter:
+        case Pivot::Center:
+        case Pivot::BottomCenter:
+            x = w * 0.5f;
+            break;
+        default:
+            x = w;
+            break;
+        }
+        switch (pivot)
+        {
+        case Pivot::TopLeft:
+        case Pivot::TopCenter:
+        case Pivot::TopRight:
+            y = 0.0f;
+            break;
+        case Pivot::CenterLeft:
+        case Pivot::Center:
+        case Pivot::CenterRight:
+            y = h * 0.5f;
+            break;
+        default:
+            y = h;
+            break;
+        }
+    }
+
+    SpriteLayer::Handle SpriteLayer::Add(const SpriteNode &node)
+    {
+        nodes.push_back({node});
+        dirty = true;
+        return nodes.size() - 1;
+    }
+
+    void SpriteLayer::Set(Handle handle, const SpriteNode &node)
+    {
+        nodes[handle].node = node;
+        dirty = true;
+    }
+
+    void SpriteLayer::Clear()
+    {
+        nodes.clear();
+        dirty = true;
+    }
+
+    void SpriteLayer::Layout(int outputWidth, int outputHeight)
+    {
+        for (Entry &entry : nodes)
+        {
+            const SpriteNode &node = entry.node;
+            SDL_FRect rect = utils::image::GetImageRect(outputWidth, outputHeight, node.widthRatio, node.heightRatio,
+                                                        node.aspectRatio, utils::image::Pivot::TopLeft, node.scaleMode);
+            float pivotX, pivotY;
+            PivotOffset(node.pivot, rect.w, rect.h, pivotX, pivotY);
+            rect.x = outputWidth * node.anchorX - pivotX;
+            rect.y = outputHeight * node.anchorY - pivotY;
+
+            entry.rect = rect;
+            entry.rasterWidth = static_cast<int>(std::lround(rect.w));
+            entry.rasterHeight = static_cast<int>(std::lround(rect.h));
+        }
+        layoutWidth = outputWidth;
+        layoutHeight = outputHeight;
+        dirty = false;
+    }
+
+    void SpriteLayer::Prefetch(int outputWidth, int outputHeight)
+    {
+        Layout(outputWidth, outputHeight);
+        for (const Entry &entry : nodes)
+        {
+            if (!entry.node.svg.empty())
+                svgs->Prefetch(entry.node.svg, entry.rasterWidth, entry.rasterHeight);
+        }
+    }
+
+    void SpriteLayer::Render(render::CommandBuffer &commands, int outputWidth, int outputHeight)
+    {
+        if (dirty || outputWidth != layoutWidth || outputHeight != layoutHeight)
+        {
+            Layout(outputWidth, outputHeight);
+        }
+
+        for (const Entry &entry : nodes)
+        {
+            if (!entry.node.visible)
+                continue;
+            SDL_Texture *texture = entry.node.svg.empty()
+                                       ? textures->Get(entry.node.texture, entry.rect.w, entry.rect.h)
+                                       : svgs->Get(entry.node.svg, entry.rasterWidth, entry.rasterHeight);
+            commands.Texture(texture, nullptr, &entry.rect);
+        }
+    }
+
+} // namespace core::scene
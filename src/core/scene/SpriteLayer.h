@@ -0,0 +1,94 @@
+#ifndef CORE_SCENE_SPRITE_LAYER_H
+#define CORE_SCENE_SPRITE_LAYER_H
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <vector>
+
+#include "core/render/CommandBuffer.h"
+#include "core/render/SvgCache.h"
+#include "core/render/TextureManager.h"
+#include "core/utils/image/Texture.h"
+
+namespace core::scene
+{
+
+    /**
+     * @brief A non-UI sprite placed relative to the render output.
+     *
+     * The sprite is sized with core::utils::image::GetImageRect() inside `widthRatio` x `heightRatio`
+     * of the output, then moved so that its `pivot` point lies on the `anchor` point of the output
+     * (0..1 on each axis).
+     */
+    struct SpriteNode
+    {
+        render::TextureId texture{render::INVALID_TEXTURE}; ///< Drawn through the TextureManager variants.
+        std::string svg;                                     ///< Drawn through the SvgCache instead, when set.
+
+        float anchorX{0.5f};
+        float anchorY{0.5f};
+        utils::image::Pivot pivot{utils::image::Pivot::Center};
+        utils::image::ScaleMode scaleMode{utils::image::ScaleMode::Fit};
+        float widthRatio{1.0f};
+        float heightRatio{1.0f};
+        float aspectRatio{1.0f}; ///< Width over height; ignored by ScaleMode::Stretch.
+        bool visible{true};
+    };
+
+    /**
+     * @brief Retained sprites of a scene, laid out once per output size.
+     *
+     * Render() only recomputes the rects when the output size differs from the last layout or a
+     * node was changed, so a steady frame is just the draws.
+     */
+    class SpriteLayer
+    {
+    public:
+        using Handle = size_t;
+
+        SpriteLayer(render::TextureManager *textures, render::SvgCache *svgs)
+            : textures(textures), svgs(svgs) {}
+
+        /// Nodes are drawn in the order they are added.
+        Handle Add(const SpriteNode &node);
+
+        const SpriteNode &Get(Handle handle) const { return nodes[handle].node; }
+        void Set(Handle handle, const SpriteNode &node);
+        void SetVisible(Handle handle, bool visible) { nodes[handle].node.visible = visible; }
+
+        /**
+         * @brief Where the node was drawn last; valid after the first Render().
+         */
+        const SDL_FRect &GetRect(Handle handle) const { return nodes[handle].rect; }
+
+        void Clear();
+
+        void Render(render::CommandBuffer &commands, int outputWidth, int outputHeight);
+
+        /**
+         * @brief Lays the nodes out for that output size and starts rasterizing their SVGs in the background.
+         */
+        void Prefetch(int outputWidth, int outputHeight);
+
+    private:
+        struct Entry
+        {
+            SpriteNode node;
+            SDL_FRect rect{};
+            int rasterWidth{0}; ///< Rect size rounded for the SvgCache.
+            int rasterHeight{0};
+        };
+
+        render::TextureManager *textures;
+        render::SvgCache *svgs;
+        std::vector<Entry> nodes;
+        int layoutWidth{-1};
+        int layoutHeight{-1};
+        bool dirty{true};
+
+        void Layout(int outputWidth, int outputHeight);
+    };
+
+} // namespace core::scene
+
+#endif // CORE_SCENE_SPRITE_LAYER_H
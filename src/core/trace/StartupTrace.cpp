@@ -0,0 +1,99 @@
+#include "core/trace/StartupTrace.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace core::trace
+{
+
+    struct Step
+    {
+        std::string name;
+        SDL_ThreadID thread;
+        Uint64 start;
+        Uint64 end;
+    };
+
+    // A spinlock needs no creation, so steps can be recorded before SDL_Init and from any thread.
+    static SDL_SpinLock lock = 0;
+    static std::vector<Step> steps;
+    static bool recording = true;
+    static Uint64 firstFrameNS = 0;
+    static SDL_ThreadID mainThread = 0;
+
+    Scope::Scope(const char *name)
+        : name(name), start(SDL_GetTicksNS())
+    {
+    }
+
+    void Scope::End()
+    {
+        if (!name)
+            return;
+        Record(name, start, SDL_GetTicksNS());
+        name = nullptr;
+    }
+
+    void Record(const char *name, Uint64 start, Uint64 end)
+    {
+        SDL_LockSpinlock(&lock);
+        if (recording)
+            steps.push_back({name, SDL_GetCurrentThreadID(), start, end});
+        SDL_UnlockSpinlock(&lock);
+    }
+
+    bool MarkFirstFrame()
+    {
+        SDL_LockSpinlock(&lock);
+        const bool first = recording;
+        if (first)
+        {
+            recording = false;
+            firstFrameNS = SDL_GetTicksNS();
+            mainThread = SDL_GetCurrentThreadID();
+            std::stable_sort(steps.begin(), steps.end(), [](const Step &a, const Step &b)
+                             { return a.start < b.start; });
+        }
+        SDL_UnlockSpinlock(&lock);
+        return first;
+    }
+
+    Uint64 GetFirstFrameNS()
+    {
+        return firstFrameNS;
+    }
+
+    void Report(Uint64 targetNS)
+    {
+        // Recording has stopped, nothing writes the steps anymore.
+        for (const Step &step : steps)
+        {
+            SDL_Log("startup %-24s %8.2f ms .. %8.2f ms %8.2f ms%s", step.name.c_str(), step.start / 1e6, step.end / 1e6,
+                    (step.end - step.start) / 1e6, step.thread == mainThread ? "" : "  (worker)");
+        }
+        if (targetNS && firstFrameNS > targetNS)
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "First frame after %.2f ms, over the %.2f ms target", firstFrameNS / 1e6, targetNS / 1e6);
+        else
+            SDL_Log("First frame after %.2f ms", firstFrameNS / 1e6);
+    }
+
+    bool WriteChromeTrace(const char *path)
+    {
+        SDL_IOStream *io = SDL_IOFromFile(path, "w");
+        if (!io)
+            return false;
+
+        bool ok = SDL_IOprintf(io, "{\"traceEvents\":[\n") > 0;
+        for (const Step &step : steps)
+        {
+            // Complete events, in microseconds. Step names are identifiers and paths, nothing to escape.
+            ok = ok && SDL_IOprintf(io, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%llu,\"ts\":%.3f,\"dur\":%.3f},\n", step.name.c_str(),
+                                    (unsigned long long)step.thread, step.start / 1e3, (step.end - step.start) / 1e3) > 0;
+        }
+        ok = ok && SDL_IOprintf(io, "{\"name\":\"first frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%llu,\"ts\":%.3f}\n]}\n",
+                                (unsigned long long)mainThread, firstFrameNS / 1e3) > 0;
+        return SDL_CloseIO(io) && ok;
+    }
+
+} // namespace core::trace
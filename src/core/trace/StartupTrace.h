@@ -0,0 +1,66 @@
+#ifndef CORE_TRACE_STARTUP_TRACE_H
+#define CORE_TRACE_STARTUP_TRACE_H
+
+#include <SDL3/SDL.h>
+
+/**
+ * @brief Timeline of the startup steps, from SDL_Init to the first presented frame.
+ *
+ * Steps are recorded from any thread with a Scope, so the steps that run concurrently show up
+ * side by side. Recording stops at MarkFirstFrame(); afterwards a Scope costs one branch.
+ * Times are SDL ticks, i.e. nanoseconds since SDL was initialized.
+ */
+namespace core::trace
+{
+
+    /**
+     * @brief Records the lifetime of the scope as a step on the calling thread.
+     * @param name Must outlive the scope; copied when the step is recorded.
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(const char *name);
+        ~Scope() { End(); }
+
+        /**
+         * @brief Records the step now rather than at the end of the scope; later calls do nothing.
+         */
+        void End();
+
+        /// Non-copyable
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        const char *name; ///< nullptr once recorded.
+        Uint64 start;
+    };
+
+    /**
+     * @brief Records a step that has already ended on the calling thread, e.g. a job timed by the scheduler.
+     */
+    void Record(const char *name, Uint64 start, Uint64 end);
+
+    /**
+     * @brief Ends recording. The first call returns true and fixes the first-frame time, later calls do nothing.
+     */
+    bool MarkFirstFrame();
+
+    /// Nanoseconds from SDL_Init to MarkFirstFrame(), 0 before it.
+    Uint64 GetFirstFrameNS();
+
+    /**
+     * @brief Logs every step and the first-frame time, with a warning when it exceeds `targetNS`.
+     */
+    void Report(Uint64 targetNS);
+
+    /**
+     * @brief Writes the steps in the Chrome trace event format, for chrome://tracing or Perfetto.
+     * @return false with SDL_GetError() set if the file can't be written.
+     */
+    bool WriteChromeTrace(const char *path);
+
+} // namespace core::trace
+
+#endif // CORE_TRACE_STARTUP_TRACE_H
@@ -0,0 +1,46 @@
+// Actions.h
+#ifndef GAME_ACTIONS_H
+#define GAME_ACTIONS_H
+
+#include "core/input/Input.h"
+
+namespace game::actions
+{
+    enum Action
+    {
+        P1_UP,
+        P1_DOWN,
+        P2_UP,
+        P2_DOWN,
+        BACK
+    };
+
+    /**
+     * @brief Installs the default key and gamepad layout.
+     * Player 1 uses W/S and the first gamepad, player 2 uses the arrows and the second gamepad.
+     */
+    inline void BindDefaults(core::input::Manager &input)
+    {
+        using core::input::Binding;
+
+        input.Bind(P1_UP, Binding::Key(SDL_SCANCODE_W));
+        input.Bind(P1_UP, Binding::Button(SDL_GAMEPAD_BUTTON_DPAD_UP, 0));
+        input.Bind(P1_UP, Binding::Axis(SDL_GAMEPAD_AXIS_LEFTY, -1, 0));
+        input.Bind(P1_DOWN, Binding::Key(SDL_SCANCODE_S));
+        input.Bind(P1_DOWN, Binding::Button(SDL_GAMEPAD_BUTTON_DPAD_DOWN, 0));
+        input.Bind(P1_DOWN, Binding::Axis(SDL_GAMEPAD_AXIS_LEFTY, 1, 0));
+
+        input.Bind(P2_UP, Binding::Key(SDL_SCANCODE_UP));
+        input.Bind(P2_UP, Binding::Button(SDL_GAMEPAD_BUTTON_DPAD_UP, 1));
+        input.Bind(P2_UP, Binding::Axis(SDL_GAMEPAD_AXIS_LEFTY, -1, 1));
+        input.Bind(P2_DOWN, Binding::Key(SDL_SCANCODE_DOWN));
+        input.Bind(P2_DOWN, Binding::Button(SDL_GAMEPAD_BUTTON_DPAD_DOWN, 1));
+        input.Bind(P2_DOWN, Binding::Axis(SDL_GAMEPAD_AXIS_LEFTY, 1, 1));
+
+        input.Bind(BACK, Binding::Key(SDL_SCANCODE_ESCAPE));
+        input.Bind(BACK, Binding::Button(SDL_GAMEPAD_BUTTON_BACK, 0));
+        input.Bind(BACK, Binding::Button(SDL_GAMEPAD_BUTTON_BACK, 1));
+    }
+} // namespace game::actions
+
+#endif // GAME_ACTIONS_H
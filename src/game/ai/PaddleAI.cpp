@@ -0,0 +1,84 @@
+#include "game/ai/PaddleAI.h"
+
+#include <cmath>
+
+namespace game::ai
+{
+    float PredictInterceptY(const Position &position, const Velocity &velocity, float targetX, float minY, float maxY)
+    {
+        const float span = maxY - minY;
+        if (velocity.x == 0.0f || span <= 0.0f)
+            return position.y;
+
+        // Unfold the walls: travel on an infinite strip, then mirror back into [minY, maxY].
+        const float time = (targetX - position.x) / velocity.x;
+        const float unfolded = position.y + velocity.y * time - minY;
+        float folded = std::fmod(unfolded, 2.0f * span);
+        if (folded < 0.0f)
+            folded += 2.0f * span;
+
+        return folded <= span ? minY + folded : minY + 2.0f * span - folded;
+    }
+
+    PaddleAI::PaddleAI(Difficulty difficulty, uint32_t seed)
+        : difficulty(difficulty), rng(seed ? seed : 0x9E3779B9u)
+    {
+    }
+
+    void PaddleAI::Reset(float restY)
+    {
+        target = restY;
+        pendingTarget = restY;
+        reactionTimer = -1.0f;
+        hasPrediction = false;
+    }
+
+    float PaddleAI::Update(float deltaTime, const Position &ball, const Velocity &velocity,
+                           float paddleX, float paddleHeight, float minY, float maxY)
+    {
+        // A pure vertical flip is a wall bounce, which the current prediction already covers.
+        const bool wallBounce = velocity.x == lastVelocity.x && velocity.y == -lastVelocity.y;
+        const bool changedCourse = velocity.x != lastVelocity.x || (velocity.y != lastVelocity.y && !wallBounce);
+
+        if (!hasPrediction || changedCourse)
+        {
+            lastVelocity = velocity;
+            hasPrediction = true;
+
+            const bool approaching = (paddleX - ball.x) * velocity.x > 0.0f;
+            if (approaching)
+            {
+                pendingTarget = PredictInterceptY(ball, velocity, paddleX, minY, maxY) +
+                                NextSignedUnit() * difficulty.error * paddleHeight * 0.5f;
+                predictions++;
+            }
+            else
+            {
+                // Drift back to the middle while the ball is going away.
+                pendingTarget = (minY + maxY) * 0.5f;
+            }
+            reactionTimer = difficulty.reactionDelay;
+        }
+        else if (wallBounce)
+        {
+            lastVelocity = velocity;
+        }
+
+        if (reactionTimer >= 0.0f)
+        {
+            reactionTimer -= deltaTime;
+            if (reactionTimer < 0.0f)
+                target = pendingTarget;
+        }
+        return target;
+    }
+
+    float PaddleAI::NextSignedUnit()
+    {
+        // xorshift32: deterministic per controller, so headless runs are reproducible.
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return (rng >> 8) * (2.0f / 16777216.0f) - 1.0f;
+    }
+} // namespace game::ai
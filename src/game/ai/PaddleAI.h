@@ -0,0 +1,86 @@
+#ifndef GAME_AI_PADDLE_AI_H
+#define GAME_AI_PADDLE_AI_H
+
+#include <cstdint>
+#include "game/Components.h"
+
+namespace game::ai
+{
+    /**
+     * @brief Tunables for the computer-controlled paddle.
+     */
+    struct Difficulty
+    {
+        float reactionDelay{0.15f}; ///< Seconds between the ball changing course and the paddle reacting.
+        float error{0.25f};         ///< Maximum aiming error, as a fraction of half the paddle height: at 1 the ball can land on the paddle edge.
+        float speedFactor{1.5f};    ///< Paddle speed relative to a human paddle.
+    };
+
+    inline constexpr Difficulty EASY{0.35f, 0.75f, 1.0f};
+    inline constexpr Difficulty NORMAL{0.15f, 0.25f, 1.5f};
+    inline constexpr Difficulty HARD{0.05f, 0.05f, 2.0f};
+
+    /**
+     * @brief Vertical position of the ball when it reaches `targetX`, in closed form.
+     * Reflections off the walls are folded in, so the cost does not depend on how many
+     * bounces happen before the ball arrives.
+     * @param position Current ball position.
+     * @param velocity Ball direction (any magnitude); must have a non-zero x component.
+     * @param targetX Horizontal coordinate to reach.
+     * @param minY Lowest y the ball reaches before bouncing off the top wall.
+     * @param maxY Highest y the ball reaches before bouncing off the bottom wall.
+     */
+    float PredictInterceptY(const Position &position, const Velocity &velocity, float targetX, float minY, float maxY);
+
+    /**
+     * @brief Trajectory-predicting controller for one paddle.
+     * The intercept is only recomputed when the ball changes course; wall bounces are already
+     * part of the prediction and do not trigger a new one. The state is a few floats and
+     * needs no allocation, so thousands of controllers can run side by side.
+     */
+    class PaddleAI
+    {
+    public:
+        explicit PaddleAI(Difficulty difficulty = NORMAL, uint32_t seed = 0x9E3779B9u);
+
+        void SetDifficulty(Difficulty value) { difficulty = value; }
+        const Difficulty &GetDifficulty() const { return difficulty; }
+
+        /**
+         * @brief Forgets the current prediction, e.g. after a reset or a resize.
+         * @param restY Position to aim at until the next prediction.
+         */
+        void Reset(float restY);
+
+        /**
+         * @brief Advances the controller.
+         * @param deltaTime Time since the last update.
+         * @param ball Ball position, in the same coordinates as the limits.
+         * @param velocity Ball direction.
+         * @param paddleX Horizontal coordinate where the ball meets the paddle.
+         * @param paddleHeight Height of the paddle, used to scale the aiming error.
+         * @param minY Top bounce limit of the ball.
+         * @param maxY Bottom bounce limit of the ball.
+         * @return The y the paddle should align with, in the same coordinates as the ball.
+         */
+        float Update(float deltaTime, const Position &ball, const Velocity &velocity,
+                     float paddleX, float paddleHeight, float minY, float maxY);
+
+        /// Number of predictions made so far; useful to check the recompute rate.
+        uint32_t GetPredictionCount() const { return predictions; }
+
+    private:
+        Difficulty difficulty;
+        uint32_t rng;
+        Velocity lastVelocity{};
+        float target{0.0f};
+        float pendingTarget{0.0f};
+        float reactionTimer{-1.0f};
+        uint32_t predictions{0};
+        bool hasPrediction{false};
+
+        float NextSignedUnit();
+    };
+} // namespace game::ai
+
+#endif // GAME_AI_PADDLE_AI_H
@@ -0,0 +1,262 @@
+#include "game/sim/Match.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace game::sim
+{
+    /// Closed intervals, like SDL_HasRectIntersectionFloat; a box with a negative size is empty.
+    static bool Intersects(const Rect &a, const Rect &b)
+    {
+        if (a.w < 0.0f || a.h < 0.0f || b.w < 0.0f || b.h < 0.0f)
+            return false;
+        return a.x <= b.x + b.w && b.x <= a.x + a.w && a.y <= b.y + b.h && b.y <= a.y + a.h;
+    }
+
+    Match::Match(mode::Mode mode, Rules rules, uint32_t seed)
+        : mode(mode), rules(rules), rng(seed ? seed : 0x9E3779B9u)
+    {
+        // Each AI gets its own stream, derived from the match seed.
+        paddles[0].ai = ai::PaddleAI{ai::NORMAL, rng * 0x85EBCA6Bu + 1};
+        paddles[1].ai = ai::PaddleAI{ai::NORMAL, rng * 0xC2B2AE35u + 2};
+    }
+
+    void Match::SetField(float width, float height)
+    {
+        field = Size2D{width, height};
+        ball.radius = Radius{std::min(width, height) / 72};
+        ball.rect.w = ball.radius.value * 2;
+        ball.rect.h = ball.radius.value * 2;
+        paddles[0].rect = {ball.radius.value, height * 0.5f, ball.radius.value, ball.radius.value * 8};
+        if (mode != mode::SOLO)
+        {
+            paddles[1].rect = {width - 2 * ball.radius.value, height * 0.5f, ball.radius.value, ball.radius.value * 8};
+        }
+    }
+
+    void Match::Resize(float width, float height)
+    {
+        const float xDiff = width / field.width;
+        const float yDiff = height / field.height;
+        ball.speed.value *= xDiff;
+        paddles[0].speed.value *= yDiff;
+        paddles[1].speed.value *= yDiff;
+        // Sized from the previous field, as the game always did; SetField() uses the new one.
+        ball.radius = Radius{std::min(field.width, field.height) / 72};
+        ball.rect.w = ball.radius.value * 2;
+        ball.rect.h = ball.radius.value * 2;
+        paddles[0].rect.w = ball.radius.value;
+        paddles[0].rect.h = ball.radius.value * 8;
+        paddles[0].rect.y *= yDiff;
+        if (mode != mode::SOLO)
+        {
+            paddles[1].rect.w = ball.radius.value;
+            paddles[1].rect.h = ball.radius.value * 8;
+            paddles[1].rect.x *= xDiff;
+            paddles[1].rect.y *= yDiff;
+        }
+        ball.rect.x *= xDiff;
+        ball.rect.y *= yDiff;
+        field = Size2D{width, height};
+        ResetAI();
+    }
+
+    void Match::Reset()
+    {
+        scores[0] = 0;
+        scores[1] = 0;
+        soloScore = 0;
+        gameTime = 0;
+        secondCounter = 0.0f;
+        paddleCooldown = 0;
+        over = false;
+        stats = {};
+        ResetBall();
+    }
+
+    void Match::SetAI(int paddle, ai::Difficulty difficulty)
+    {
+        paddles[paddle].automatic = true;
+        paddles[paddle].ai.SetDifficulty(difficulty);
+        ResetAI();
+    }
+
+    int Match::GetWinner() const
+    {
+        if (!over || mode == mode::SOLO)
+            return -1;
+        return scores[0] > scores[1] ? 0 : 1;
+    }
+
+    uint32_t Match::Step(float deltaTime)
+    {
+        uint32_t events = NONE;
+
+        // On solo mode, count the seconds to keep the score
+        if (mode == mode::SOLO && !over)
+        {
+            secondCounter += deltaTime;
+            while (secondCounter >= 1.0f)
+            {
+                secondCounter -= 1.0f;
+                gameTime++;
+                multiplier = static_cast<int>(std::log10(gameTime)) + 1;
+                soloScore += 10 * multiplier;
+                events |= SCORE_CHANGED;
+            }
+        }
+
+        events |= CheckCollisions();
+        ball.rect.x += ball.velocity.x * deltaTime * ball.speed.value;
+        ball.rect.y += ball.velocity.y * deltaTime * ball.speed.value;
+
+        MovePaddle(0, deltaTime);
+        if (mode != mode::SOLO)
+        {
+            MovePaddle(1, deltaTime);
+        }
+
+        stats.steps++;
+        stats.time += deltaTime;
+        if (field.width > 0.0f)
+            stats.maxBallSpeed = std::max(stats.maxBallSpeed, ball.speed.value / field.width);
+        return events;
+    }
+
+    void Match::MovePaddle(int index, float deltaTime)
+    {
+        Paddle &paddle = paddles[index];
+        if (paddle.automatic)
+        {
+            // Aim the paddle center at the predicted ball center, at the side of the paddle facing the field
+            const float paddleX = index == 0 ? paddle.rect.x + paddle.rect.w : paddle.rect.x - ball.rect.w;
+            const float targetY = paddle.ai.Update(deltaTime, Position{ball.rect.x, ball.rect.y}, ball.velocity, paddleX,
+                                                   paddle.rect.h, ball.radius.value, field.height - ball.radius.value);
+            const float distance = (targetY + ball.rect.h * 0.5f) - (paddle.rect.y + paddle.rect.h * 0.5f);
+            const float maxStep = paddle.speed.value * paddle.ai.GetDifficulty().speedFactor * deltaTime;
+            paddle.rect.y += std::clamp(distance, -maxStep, maxStep);
+        }
+        else
+        {
+            paddle.rect.y += paddle.direction * paddle.speed.value * deltaTime;
+        }
+        paddle.rect.y = std::clamp(paddle.rect.y, 0.0f, field.height - paddle.rect.h);
+    }
+
+    uint32_t Match::CheckCollisions()
+    {
+        uint32_t events = NONE;
+
+        if (paddleCooldown > 0)
+            paddleCooldown--;
+        const bool inPaddleBounds = ball.rect.x < field.width * 0.15f || ball.rect.x > field.width * 0.85f;
+        if (inPaddleBounds && paddleCooldown == 0)
+        {
+            const Paddle &paddle = paddles[ball.rect.x < field.width / 2 ? 0 : 1];
+            if (Intersects(ball.rect, paddle.rect))
+            {
+                // Change bounce depending on impact zone, from -45° to 45°
+                const float paddleCenterY = paddle.rect.y + paddle.rect.h / 2;
+                const float offset = std::clamp((ball.rect.y - paddleCenterY) / (paddle.rect.h / 2), -1.0f, 1.0f);
+                const float angle = offset * std::numbers::pi_v<float> / 4;
+                const float direction = ball.velocity.x > 0 ? -1.0f : 1.0f;
+                ball.velocity.x = std::cos(angle) * direction;
+                ball.velocity.y = std::sin(angle);
+                ball.speed.value += rules.paddleSpeedup * ball.radius.value;
+                soloScore += multiplier * 50;
+                paddleCooldown = rules.paddleCooldownSteps;
+                stats.paddleHits++;
+                events |= PADDLE_HIT;
+            }
+        }
+
+        // World boundaries: a goal when the edge of the ball touches the left or right edge of the
+        // field, the same test on both sides. The right wall bounces in solo mode
+        const float centerX = ball.rect.x + ball.radius.value;
+        if (centerX + ball.radius.value >= field.width)
+        {
+            if (mode == mode::SOLO)
+            {
+                ball.velocity.x *= -1;
+                stats.wallBounces++;
+                events |= WALL_BOUNCE;
+            }
+            else
+            {
+                events |= Goal(0);
+            }
+        }
+        else if (centerX - ball.radius.value <= 0.0f)
+        {
+            events |= Goal(1);
+        }
+
+        if (ball.rect.y + ball.radius.value >= field.height || ball.rect.y <= ball.radius.value)
+        {
+            ball.velocity.y *= -1;
+            ball.speed.value += rules.wallSpeedup * ball.radius.value;
+            stats.wallBounces++;
+            events |= WALL_BOUNCE;
+        }
+        return events;
+    }
+
+    uint32_t Match::Goal(int scorer)
+    {
+        scores[scorer]++;
+        if (scores[0] < rules.winningPoints && scores[1] < rules.winningPoints)
+        {
+            ResetBall();
+            return GOAL | SCORE_CHANGED;
+        }
+
+        // The ball rests in the middle once the match is over.
+        over = true;
+        ball.speed.value = 0;
+        ball.rect.x = field.width / 2;
+        ball.rect.y = field.height / 2;
+        return GOAL | SCORE_CHANGED | GAME_OVER;
+    }
+
+    void Match::ResetBall()
+    {
+        const float speed = rules.initialSpeed * field.width;
+        ball.speed.value = speed;
+        paddles[0].speed.value = speed;
+        paddles[1].speed.value = speed;
+        multiplier = 1;
+        ball.rect.x = field.width / 2;
+        ball.rect.y = field.height / 2;
+
+        // Any direction but close to vertical
+        constexpr float PI = std::numbers::pi_v<float>;
+        float angle = 2 * PI * NextUnit();
+        while ((angle >= PI / 3 && angle <= 2 * PI / 3) || (angle >= 4 * PI / 3 && angle <= 5 * PI / 3))
+        {
+            angle = 2 * PI * NextUnit();
+        }
+        ball.velocity.x = std::cos(angle);
+        ball.velocity.y = std::sin(angle);
+        ResetAI();
+    }
+
+    void Match::ResetAI()
+    {
+        // Hold the current paddle position until the first prediction kicks in
+        for (Paddle &paddle : paddles)
+        {
+            if (paddle.automatic)
+                paddle.ai.Reset(paddle.rect.y + (paddle.rect.h - ball.rect.h) * 0.5f);
+        }
+    }
+
+    float Match::NextUnit()
+    {
+        // xorshift32, like PaddleAI: SDL_randf() is shared by the whole process.
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return (rng >> 8) * (1.0f / 16777216.0f);
+    }
+} // namespace game::sim
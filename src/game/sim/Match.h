@@ -0,0 +1,141 @@
+#ifndef GAME_SIM_MATCH_H
+#define GAME_SIM_MATCH_H
+
+#include <cstdint>
+#include "game/Components.h"
+#include "game/Mode.h"
+#include "game/ai/PaddleAI.h"
+
+namespace game::sim
+{
+    /// Axis-aligned box, top-left corner and size, in field pixels.
+    struct Rect
+    {
+        float x{0.0f}, y{0.0f}, w{0.0f}, h{0.0f};
+    };
+
+    /**
+     * @brief Gameplay constants, relative to the field so they hold at any resolution.
+     */
+    struct Rules
+    {
+        float initialSpeed{1.0f / 3.0f}; ///< Ball and paddle speed after every goal, in field widths per second.
+        float paddleSpeedup{1.0f};       ///< Ball speed gained on a paddle hit, in ball radii per second.
+        float wallSpeedup{0.2f};         ///< Ball speed gained on a top or bottom wall bounce, in ball radii per second.
+        int winningPoints{5};            ///< Goals to win; in solo mode, balls the player can lose.
+        int paddleCooldownSteps{30};     ///< Steps after a paddle hit during which paddles don't collide, so the ball can't get stuck.
+    };
+
+    /// What happened during a Step(), as a combination of flags.
+    enum Event : uint32_t
+    {
+        NONE = 0,
+        WALL_BOUNCE = 1 << 0,
+        PADDLE_HIT = 1 << 1,
+        GOAL = 1 << 2,
+        SCORE_CHANGED = 1 << 3, ///< A goal, or the solo score ticked.
+        GAME_OVER = 1 << 4,
+    };
+
+    struct Stats
+    {
+        uint32_t steps{0};
+        float time{0.0f}; ///< Simulated seconds.
+        uint32_t paddleHits{0};
+        uint32_t wallBounces{0};
+        float maxBallSpeed{0.0f}; ///< In field widths per second.
+    };
+
+    /**
+     * @brief One Pong match: the ball, the paddles, the score and the optional paddle AIs.
+     *
+     * Has no dependency on SDL, the renderer or the audio mixer, and no shared state: the scene
+     * plays it in real time and reacts to the events Step() returns, while batch tools step
+     * thousands of them side by side on several threads. With the same seed, rules and inputs,
+     * a match always plays out the same way.
+     */
+    class Match
+    {
+    public:
+        explicit Match(mode::Mode mode, Rules rules = {}, uint32_t seed = 1);
+
+        /**
+         * @brief Sizes the ball and places the paddles for a field of the given size. Call before Reset().
+         */
+        void SetField(float width, float height);
+
+        /**
+         * @brief Scales the current state to a new field size, e.g. after a window resize.
+         */
+        void Resize(float width, float height);
+
+        /// Starts over: scores, solo timer and a ball served in a random direction.
+        void Reset();
+
+        /// Movement of a paddle without AI: -1 up, 1 down, 0 still.
+        void SetDirection(int paddle, int direction) { paddles[paddle].direction = direction; }
+
+        /// Lets a PaddleAI drive the paddle from now on.
+        void SetAI(int paddle, ai::Difficulty difficulty);
+
+        /**
+         * @brief Advances the match by `deltaTime` seconds.
+         * @return The Event flags raised during the step.
+         */
+        uint32_t Step(float deltaTime);
+
+        mode::Mode GetMode() const { return mode; }
+        const Rules &GetRules() const { return rules; }
+        Size2D GetFieldSize() const { return field; }
+        const Rect &GetBall() const { return ball.rect; }
+        const Rect &GetPaddle(int paddle) const { return paddles[paddle].rect; }
+        int GetScore(int player) const { return scores[player]; }
+        int GetSoloScore() const { return soloScore; }
+        bool IsOver() const { return over; }
+        /// Index of the player who won, -1 while playing and in solo mode.
+        int GetWinner() const;
+        const Stats &GetStats() const { return stats; }
+
+    private:
+        struct Ball
+        {
+            Rect rect;
+            Radius radius;
+            Velocity velocity;
+            Speed speed;
+        };
+
+        struct Paddle
+        {
+            Rect rect;
+            Speed speed;
+            int direction{0};
+            bool automatic{false};
+            ai::PaddleAI ai;
+        };
+
+        mode::Mode mode;
+        Rules rules;
+        uint32_t rng;
+        Size2D field;
+        Ball ball;
+        Paddle paddles[2];
+        int scores[2]{0, 0};
+        int soloScore{0};
+        int multiplier{1};
+        int gameTime{0};
+        float secondCounter{0.0f}; ///< Seconds since the last solo tick.
+        int paddleCooldown{0};
+        bool over{false};
+        Stats stats;
+
+        void ResetBall();
+        void ResetAI();
+        void MovePaddle(int paddle, float deltaTime);
+        uint32_t CheckCollisions();
+        uint32_t Goal(int scorer);
+        float NextUnit();
+    };
+} // namespace game::sim
+
+#endif // GAME_SIM_MATCH_H
@@ -2,12 +2,16 @@
 #include <SDL3/SDL_main.h>
 #include <SDL3/SDL_init.h>
 // #include <SDL3_ttf/SDL_ttf.h>
-#include <SDL3_mixer/SDL_mixer.h>
 #include <SDL3_image/SDL_image.h>
 #include <cmath>
 #include <filesystem>
 
 #include "scenes/ScreenManager.h"
+#include "game/Actions.h"
+#include "core/input/EventCoalescer.h"
+#include "core/memory/AllocationTracker.h"
+#include "core/render/CompactTextures.h"
+#include "core/trace/StartupTrace.h"
 
 // RmlUi
 #include <RmlUi/Core/Context.h>
@@ -27,6 +31,171 @@ Uint64 currentTick = 0;
 float delta_time = 0;
 
 core::scene::Manager *screenManager{nullptr};
+/// Time the end of a frame may spend on deferred releases.
+Uint64 releaseBudgetNS{0};
+core::input::EventCoalescer eventQueue;
+
+#ifdef CORE_TRACK_ALLOCATIONS
+bool allocationOverlayVisible = true;
+
+/// Draws the allocation counters of the last completed frame in the top-left corner.
+static void RenderAllocationOverlay(core::render::CommandBuffer &commands)
+{
+    using namespace core::memory::tracking;
+    const FrameReport &report = GetLastFrame();
+    const float lineHeight = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE + 2.0f;
+    float y = 4.0f;
+    char line[128];
+
+    commands.SetDrawColor(0xFF, 0xD0, 0x40, SDL_ALPHA_OPAQUE);
+    SDL_snprintf(line, sizeof(line), "frame %llu: %llu allocs, %llu frees, %llu bytes (over budget: %llu)",
+                 (unsigned long long)report.frame, (unsigned long long)report.total.allocations,
+                 (unsigned long long)report.total.frees, (unsigned long long)report.total.bytes,
+                 (unsigned long long)GetOverBudgetFrames());
+    commands.DebugText(4.0f, y, line);
+
+    for (int phase = 0; phase < static_cast<int>(Phase::COUNT); phase++)
+    {
+        const Counters &counters = report.phases[phase];
+        if (counters.allocations == 0 && counters.frees == 0)
+            continue;
+        y += lineHeight;
+        SDL_snprintf(line, sizeof(line), "  %-13s %6llu allocs %6llu frees %9llu bytes", GetPhaseName(static_cast<Phase>(phase)),
+                     (unsigned long long)counters.allocations, (unsigned long long)counters.frees, (unsigned long long)counters.bytes);
+        commands.DebugText(4.0f, y, line);
+    }
+
+    for (int thread = 0; thread < report.threadCount; thread++)
+    {
+        const Counters &counters = report.threads[thread];
+        if (counters.allocations == 0 && counters.frees == 0)
+            continue;
+        const char *name = GetThreadName(thread);
+        y += lineHeight;
+        SDL_snprintf(line, sizeof(line), "  [%s#%d] %6llu allocs %6llu frees %9llu bytes", name ? name : "thread", thread,
+                     (unsigned long long)counters.allocations, (unsigned long long)counters.frees, (unsigned long long)counters.bytes);
+        commands.DebugText(4.0f, y, line);
+    }
+}
+#endif
+
+#ifndef NDEBUG
+bool renderStatsOverlayVisible = false;
+
+/// Draws texture residency on two lines starting at `y`: totals, then the largest owners.
+static void RenderTextureStats(core::render::CommandBuffer &commands, const core::render::TextureManager &textures, core::memory::FrameArena &arena,
+                               float y, float lineHeight)
+{
+    const core::render::TextureManager::Stats &stats = textures.GetStats();
+    char line[160];
+
+    SDL_snprintf(line, sizeof(line), "textures %zu/%zu resident, %.1f MB of %.0f MB (peak %.1f, %.1f saved), %llu evicted, %llu reloaded, %llu variants",
+                 stats.resident, stats.textures, stats.bytes / 1048576.0, textures.GetBudget() / 1048576.0, stats.peakBytes / 1048576.0,
+                 stats.savedBytes / 1048576.0, (unsigned long long)stats.evictions, (unsigned long long)stats.reloads,
+                 (unsigned long long)stats.variantLoads);
+    commands.DebugText(4.0f, y, line);
+
+    using OwnerStats = core::render::TextureManager::OwnerStats;
+    core::memory::FrameVector<OwnerStats> owners{core::memory::ArenaAllocator<OwnerStats>{&arena}};
+    textures.GetOwnerStats(owners);
+    int length = SDL_snprintf(line, sizeof(line), "  by owner:");
+    for (const OwnerStats &owner : owners)
+    {
+        if (length >= static_cast<int>(sizeof(line)))
+            break;
+        length += SDL_snprintf(line + length, sizeof(line) - length, " %.*s %zu/%zu %.1f MB", static_cast<int>(owner.owner.size()), owner.owner.data(),
+                               owner.resident, owner.textures, owner.bytes / 1048576.0);
+    }
+    commands.DebugText(4.0f, y + lineHeight, line);
+}
+
+/// Draws the input event counters of the last drained frame at `y`.
+static void RenderEventStats(core::render::CommandBuffer &commands, float y)
+{
+    const core::input::EventCoalescer::Stats &events = eventQueue.GetStats();
+    char line[96];
+    SDL_snprintf(line, sizeof(line), "events %u received, %u delivered, %u coalesced", events.received, events.delivered, events.coalesced);
+    commands.DebugText(4.0f, y, line);
+}
+
+/// Draws the sound effect voices and the measured output latency at `y`.
+static void RenderSfxStats(core::render::CommandBuffer &commands, const core::audio::SfxMixer &sfx, float y)
+{
+    const core::audio::MixerStats stats = sfx.GetStats();
+    char line[128];
+    SDL_snprintf(line, sizeof(line), "sfx %d voices, %u played, %u stolen, latency %.1f ms (buffer %.1f ms, %d frames at %d Hz)", stats.activeVoices,
+                 stats.played, stats.stolen, stats.outputLatencyMs, stats.bufferLatencyMs, stats.deviceFrames, stats.frequency);
+    commands.DebugText(4.0f, y, line);
+}
+
+/// Draws the UI renderer counters of the current frame in the bottom-left corner.
+static void RenderStatsOverlay(core::render::CommandBuffer &commands, const AppContext &app, int outputHeight)
+{
+    const float lineHeight = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE + 2.0f;
+    char line[128];
+
+    if (app.software_interface)
+    {
+        const core::render::SoftwareRasterizer::Stats &raster = app.software_interface->GetRasterizerStats();
+        const float y = outputHeight - 3 * lineHeight - 4.0f;
+        commands.SetDrawColor(0x40, 0xD0, 0xFF, SDL_ALPHA_OPAQUE);
+        RenderSfxStats(commands, *app.sfx, y - 2 * lineHeight);
+        RenderEventStats(commands, y - lineHeight);
+        SDL_snprintf(line, sizeof(line), "ui raster %llu triangles, %llu binned, %.2f ms on %d threads", (unsigned long long)raster.triangles,
+                     (unsigned long long)raster.binned, raster.rasterNS / 1e6, raster.threads);
+        commands.DebugText(4.0f, y, line);
+        RenderTextureStats(commands, *app.textures, *app.frameArena, y + lineHeight, lineHeight);
+        return;
+    }
+
+    const RenderInterface_SDL &renderInterface = *app.render_interface;
+    const RenderInterface_SDL::CullStats &cull = renderInterface.GetCullStats();
+    const RenderInterface_SDL::GeometryPathStats &paths = renderInterface.GetGeometryPathStats();
+    const RenderInterface_SDL::UiCacheStats &cache = renderInterface.GetUiCacheStats();
+    const core::render::RenderTargetPool::Stats &targets = renderInterface.GetRenderTargetStats();
+    const RenderInterface_SDL::GeneratedTextureStats &generated = renderInterface.GetGeneratedTextureStats();
+    float y = outputHeight - 9 * lineHeight - 4.0f;
+
+    commands.SetDrawColor(0x40, 0xD0, 0xFF, SDL_ALPHA_OPAQUE);
+    RenderSfxStats(commands, *app.sfx, y);
+
+    y += lineHeight;
+    RenderEventStats(commands, y);
+
+    y += lineHeight;
+    SDL_snprintf(line, sizeof(line), "ui draws %llu, culled %llu (%llu vertices)", (unsigned long long)cull.draws,
+                 (unsigned long long)cull.culled_draws, (unsigned long long)cull.culled_vertices);
+    commands.DebugText(4.0f, y, line);
+
+    y += lineHeight;
+    SDL_snprintf(line, sizeof(line), "ui rects %llu, textured quads %llu, meshes %llu", (unsigned long long)paths.solid_rects,
+                 (unsigned long long)paths.textured_quads, (unsigned long long)paths.meshes);
+    commands.DebugText(4.0f, y, line);
+
+    y += lineHeight;
+    SDL_snprintf(line, sizeof(line), "ui cache %llu hits, %llu rebuilds, %llu bypassed", (unsigned long long)cache.hits,
+                 (unsigned long long)cache.rebuilds, (unsigned long long)cache.bypassed);
+    commands.DebugText(4.0f, y, line);
+
+    y += lineHeight;
+    SDL_snprintf(line, sizeof(line), "targets %zu live, %zu bytes (peak %zu), %.0f%% reused", targets.textures, targets.bytes,
+                 targets.peakBytes, renderInterface.GetRenderTargetHitRate() * 100.0f);
+    commands.DebugText(4.0f, y, line);
+
+    y += lineHeight;
+    SDL_snprintf(line, sizeof(line), "generated textures %llu created, %llu patched, %llu KB uploaded", (unsigned long long)generated.created,
+                 (unsigned long long)generated.reused, (unsigned long long)(generated.uploaded / 1024));
+    commands.DebugText(4.0f, y, line);
+
+    RenderTextureStats(commands, *app.textures, *app.frameArena, y + lineHeight, lineHeight);
+}
+#endif
+
+/// Caches the render output size for the scenes, which would otherwise query (and lock) the renderer every frame.
+static void RefreshOutputSize(AppContext *app)
+{
+    app->renderQueue->GetOutputSize(&app->outputWidth, &app->outputHeight);
+}
 
 SDL_AppResult SDL_Fail()
 {
@@ -34,57 +203,215 @@ SDL_AppResult SDL_Fail()
     return SDL_APP_FAILURE;
 }
 
+/// The audio device and mixers, opened by a job while the window and renderer are created.
+struct AudioStartup
+{
+    core::audio::MixerConfig sfxConfig{};
+    SDL_AudioDeviceID device{0};
+    core::audio::SfxMixer *sfx{nullptr};
+    core::audio::MusicPlayer *music{nullptr};
+    std::string error; ///< SDL_GetError() is per thread, so failures are reported through here.
+};
+
+static void OpenAudio(AudioStartup *audio)
+{
+    // The device buffer size decides the sound effect latency, so request it before opening.
+    core::audio::SfxMixer::ApplyDeviceHints(audio->sfxConfig);
+    audio->device = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, NULL);
+    if (not audio->device)
+    {
+        audio->error = SDL_GetError();
+        return;
+    }
+    audio->sfx = new core::audio::SfxMixer{};
+    if (not audio->sfx->Open(audio->device, audio->sfxConfig))
+    {
+        audio->error = SDL_GetError();
+        delete audio->sfx;
+        audio->sfx = nullptr;
+        return;
+    }
+    audio->music = new core::audio::MusicPlayer{};
+    if (not audio->music->Open(audio->device))
+    {
+        audio->error = SDL_GetError();
+        delete audio->music;
+        delete audio->sfx;
+        audio->music = nullptr;
+        audio->sfx = nullptr;
+    }
+}
+
+static void CloseAudio(AudioStartup &audio)
+{
+    delete audio.music;
+    delete audio.sfx;
+    if (audio.device)
+    {
+        SDL_CloseAudioDevice(audio.device);
+    }
+}
+
+/// Job body: rasterizes the logo and hands it to the main thread, which owns the window.
+static void LoadWindowIcon(core::jobs::Scheduler *jobs, SDL_Window *window)
+{
+    // Window managers show icons at 256 pixels at most, there's no point rasterizing the logo larger.
+    SDL_IOStream *iconFile = core::assets::OpenAsset("resources/logo.svg");
+    SDL_Surface *icon = iconFile ? IMG_LoadSizedSVG_IO(iconFile, 256, 256) : nullptr;
+    if (iconFile)
+    {
+        SDL_CloseIO(iconFile);
+    }
+    if (not icon)
+    {
+        SDL_Log("Failed to load icon: %s", SDL_GetError());
+        return;
+    }
+
+    // Video calls have to run on the main thread on most platforms.
+    jobs->RunOnMainThread([window, icon]
+                          {
+                              SDL_SetWindowIcon(window, icon);
+                              SDL_DestroySurface(icon); },
+                          nullptr, "window icon");
+}
+
+/// Named jobs become startup steps; recording ignores them after the first frame.
+static void TraceJob(const char *name, int, Uint64 startNS, Uint64 endNS)
+{
+    if (name)
+    {
+        core::trace::Record(name, startNS, endNS);
+    }
+}
+
+/// Logs the startup timeline once the first frame is out, and writes it to PONG_STARTUP_TRACE if set.
+static void ReportStartup()
+{
+    const char *targetHint = SDL_GetHint("PONG_FIRST_FRAME_TARGET_MS");
+    const Uint64 targetMS = targetHint ? SDL_strtoull(targetHint, nullptr, 10) : 500;
+    core::trace::Report(targetMS * 1000000);
+
+    const char *tracePath = SDL_GetHint("PONG_STARTUP_TRACE");
+    if (tracePath && *tracePath && !core::trace::WriteChromeTrace(tracePath))
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Couldn't write the startup trace to %s: %s", tracePath, SDL_GetError());
+    }
+}
+
 SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
 {
+    // Must come before any other SDL call so that every SDL allocation is seen.
+    if (core::memory::tracking::IsEnabled())
+    {
+        core::memory::tracking::SetThreadName("main");
+        if (!core::memory::tracking::InstallSDLHooks())
+        {
+            SDL_Log("Couldn't hook the SDL allocator, only C++ allocations will be tracked");
+        }
+    }
+
     // init the library, here we make a window so we only need the Video capabilities.
-    if (not SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO))
     {
-        return SDL_Fail();
+        core::trace::Scope step{"sdl init"};
+        if (not SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_GAMEPAD))
+        {
+            return SDL_Fail();
+        }
     }
 
+    // One worker per additional core, shared by everything that splits its work into jobs.
+    auto jobs = new core::jobs::Scheduler{};
+    jobs->SetTraceHook(TraceJob);
+
     // init TTF
     // if (not TTF_Init())
     // {
     //     return SDL_Fail();
     // }
 
-    // create a window
-
-    SDL_Window *window = SDL_CreateWindow("Pong", windowStartWidth, windowStartHeight, SDL_WINDOW_RESIZABLE | SDL_WINDOW_HIGH_PIXEL_DENSITY);
-    if (not window)
+    // Every asset is read from one memory-mapped pack when the build produced it, and from loose files otherwise.
+    auto assets = new core::assets::AssetPack{};
     {
-        return SDL_Fail();
+        core::trace::Scope step{"asset pack"};
+        const char *basePath = SDL_GetBasePath();
+        if (assets->Open(std::string(basePath ? basePath : "") + "assets.pak"))
+        {
+            core::assets::Mount(assets);
+            SDL_Log("Mounted the asset pack (%u files)", assets->GetEntryCount());
+        }
+        else
+        {
+            SDL_Log("No asset pack, reading loose files: %s", SDL_GetError());
+        }
     }
 
-    // Carga la imagen con SDL_image (si usas PNG u otros)
-    SDL_Surface *icon = IMG_Load("resources/logo.svg");
-    if (icon)
+    // init audio
+    // Nothing before the scenes needs it, and opening the device can take a while on some systems.
+    AudioStartup audio;
+    core::jobs::Counter audioOpened;
+    jobs->Run([&audio]
+              { OpenAudio(&audio); },
+              &audioOpened, "audio");
+
+    // Until the AppContext owns them, a failed startup releases these itself.
+    SDL_Window *window{nullptr};
+    SDL_Renderer *renderer{nullptr};
+    auto fail = [&]
+    {
+        const SDL_AppResult result = SDL_Fail();
+        jobs->Wait(audioOpened);
+        // Runs the queued main-thread jobs too, e.g. the window icon, while the window still exists.
+        delete jobs;
+        CloseAudio(audio);
+        if (renderer)
+        {
+            SDL_DestroyRenderer(renderer);
+        }
+        if (window)
+        {
+            SDL_DestroyWindow(window);
+        }
+        core::assets::Mount(nullptr);
+        delete assets;
+        return result;
+    };
+
+    // create a window
     {
-        SDL_SetWindowIcon(window, icon);
-        SDL_DestroySurface(icon);
+        core::trace::Scope step{"window"};
+        window = SDL_CreateWindow("Pong", windowStartWidth, windowStartHeight, SDL_WINDOW_RESIZABLE | SDL_WINDOW_HIGH_PIXEL_DENSITY);
     }
-    else
+    if (not window)
     {
-        SDL_Log("Failed to load icon: %s", SDL_GetError());
+        return fail();
     }
 
+    // Carga la imagen con SDL_image (si usas PNG u otros)
+    // Rasterized by a worker while the renderer is created.
+    jobs->Run([jobs, window]
+              { LoadWindowIcon(jobs, window); },
+              nullptr, "icon");
+
     // SDL_SetHint(SDL_HINT_RENDER_DRIVER, "opengl");
     // create a renderer
-    SDL_Renderer *renderer = SDL_CreateRenderer(window, NULL);
+    {
+        core::trace::Scope step{"renderer"};
+        renderer = SDL_CreateRenderer(window, NULL);
+    }
     if (not renderer)
     {
-        return SDL_Fail();
+        return fail();
     }
 
-    // init SDL Mixer
-    auto audioDevice = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, NULL);
-    if (not audioDevice)
     {
-        return SDL_Fail();
+        core::trace::Scope step{"wait for audio"};
+        jobs->Wait(audioOpened);
     }
-    if (not Mix_OpenAudio(audioDevice, NULL))
+    if (not audio.sfx)
     {
-        return SDL_Fail();
+        SDL_SetError("%s", audio.error.c_str());
+        return fail();
     }
 
     // print some information about the window
@@ -105,7 +432,11 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
     *appstate = new AppContext{
         .window = window,
         .renderer = renderer,
-        .audioDevice = audioDevice,
+        .audioDevice = audio.device,
+        .sfx = audio.sfx,
+        .music = audio.music,
+        .jobs = jobs,
+        .assets = assets,
     };
 
     SDL_SetRenderVSync(renderer, -1); // enable vysnc
@@ -117,13 +448,67 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
     SDL_SetHint(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH, "1");
     // Instantiate the interfaces to RmlUi.
     auto app = (AppContext *)*appstate;
-    app->render_interface = new RenderInterface_SDL(renderer);
+    app->renderQueue = new core::render::RenderQueue{renderer};
+    // Replaying on a separate thread is not supported by every SDL render driver, so it is opt-in.
+    if (SDL_GetHintBoolean("PONG_RENDER_THREAD", false) && app->renderQueue->StartThread())
+    {
+        SDL_Log("Rendering on a dedicated thread");
+    }
+    app->frameArena = new core::memory::FrameArena{};
+    // Low-memory devices get killed long before allocations fail, so texture memory is capped.
+    const char *budgetHint = SDL_GetHint("PONG_TEXTURE_BUDGET_MB");
+    const size_t textureBudgetMB = budgetHint ? SDL_strtoul(budgetHint, nullptr, 10) : 256;
+    // Opt-in for low-memory devices: 16-bit textures where the image survives it, see CompactTextures.h.
+    core::render::compact::SetEnabled(SDL_GetHintBoolean("PONG_COMPACT_TEXTURES", false));
+    app->textures = new core::render::TextureManager{renderer, app->renderQueue, textureBudgetMB * 1024 * 1024};
+    app->svgs = new core::render::SvgCache{renderer, app->renderQueue, app->textures};
+    if (SDL_GetHintBoolean("PONG_SVG_DISK_CACHE", true))
+    {
+        if (char *prefPath = SDL_GetPrefPath("asdrome", "pong"))
+        {
+            app->svgs->SetDiskCache(std::string(prefPath) + "svgcache");
+            SDL_free(prefPath);
+        }
+    }
+
+    RefreshOutputSize(app);
+    app->releases = new core::memory::DeferredReleaseQueue{};
+    const char *releaseHint = SDL_GetHint("PONG_RELEASE_BUDGET_US");
+    releaseBudgetNS = (releaseHint ? SDL_strtoull(releaseHint, nullptr, 10) : 1000) * 1000;
+
+    // The scenes' images decode on the texture and SVG workers while RmlUi starts up.
+    screenManager = new core::scene::Manager{};
+    screenManager->SetReleaseQueue(app->releases);
+    RegisterScreens(screenManager, app);
+
+    core::trace::Scope rmluiStep{"rmlui"};
+    // SDL's software renderer is slow with RmlUi's many small triangles, the UI is rasterized on the CPU instead.
+    Rml::RenderInterface *uiRenderer;
+    if (SDL_GetHintBoolean("PONG_SOFTWARE_UI", SDL_strcmp(SDL_GetRendererName(renderer), SDL_SOFTWARE_RENDERER) == 0))
+    {
+        app->software_interface = new RenderInterface_Software(renderer);
+        app->software_interface->SetRenderQueue(app->renderQueue);
+        app->software_interface->SetScheduler(app->jobs);
+        app->software_interface->SetFrameArena(app->frameArena);
+        uiRenderer = app->software_interface;
+        SDL_Log("Rasterizing the UI on the CPU");
+    }
+    else
+    {
+        app->render_interface = new RenderInterface_SDL(renderer);
+        app->render_interface->SetRenderQueue(app->renderQueue);
+        app->render_interface->SetFrameArena(app->frameArena);
+        app->render_interface->SetTextureManager(app->textures);
+        uiRenderer = app->render_interface;
+    }
     app->system_interface = new SystemInterface_SDL();
     app->system_interface->SetWindow(window);
+    app->file_interface = new FileInterface_Assets();
 
     // Begin by installing the custom interfaces.
-    Rml::SetRenderInterface(app->render_interface);
+    Rml::SetRenderInterface(uiRenderer);
     Rml::SetSystemInterface(app->system_interface);
+    Rml::SetFileInterface(app->file_interface);
 
     if (app->system_interface->LogMessage(Rml::Log::LT_INFO, Rml::CreateString("Using SDL renderer: %s", SDL_GetRendererName(app->renderer))))
     {
@@ -134,7 +519,7 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
     Rml::Log::Message(Rml::Log::LT_WARNING, "Test warning.");
 
     // Create a context next.
-    Rml::Context *context = Rml::CreateContext("main", Rml::Vector2i(windowStartWidth, windowStartHeight), app->render_interface);
+    Rml::Context *context = Rml::CreateContext("main", Rml::Vector2i(windowStartWidth, windowStartHeight), uiRenderer);
     if (!context)
     {
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Couldn't create RmlUi context");
@@ -146,12 +531,17 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
 #ifndef NDEBUG
     Rml::Debugger::Initialise(context);
 #endif
+    rmluiStep.End();
 
-    // Fonts should be loaded before any documents are loaded.
-    // if (Rml::LoadFontFace("resources/monogram.ttf"))
-    // {
-    //     SDL_Log("Loaded font");
-    // }
+    // Fonts should be loaded before any documents are loaded. Once for every scene; RmlUi's font
+    // engine isn't thread-safe, so this stays on the main thread while the images decode.
+    {
+        core::trace::Scope step{"fonts"};
+        if (!Rml::LoadFontFace("resources/monogram.ttf"))
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load resources/monogram.ttf");
+        }
+    }
 
     // Now we are ready to load our document.
     // Rml::ElementDocument *document = context->LoadDocument("resources/ui/test.rml");
@@ -164,7 +554,9 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
     // document->Show();
     app->context = context;
 
-    screenManager = new core::scene::Manager{};
+    app->input = new core::input::Manager{};
+    game::actions::BindDefaults(*app->input);
+
     InitScreenManager(screenManager, (AppContext *)*appstate);
 
     return SDL_APP_CONTINUE;
@@ -174,68 +566,55 @@ SDL_AppResult SDL_AppEvent(void *appstate, SDL_Event *event)
 {
     auto *app = (AppContext *)appstate;
 
+    app->input->ProcessEvent(*event);
+
     switch (event->type)
     {
-    case SDL_EVENT_WINDOW_RESTORED:
-    case SDL_EVENT_WINDOW_RESIZED:
-        int w, h;
-        SDL_GetCurrentRenderOutputSize(app->renderer, &w, &h);
-        app->context->SetDimensions(Rml::Vector2i(w, h));
-        break;
     case SDL_EVENT_QUIT:
         app->app_quit = SDL_APP_SUCCESS;
         break;
-    case SDL_EVENT_MOUSE_MOTION:
-        app->context->ProcessMouseMove(event->motion.x, event->motion.y, 0);
-        break;
-    case SDL_EVENT_MOUSE_BUTTON_DOWN:
-    {
-        int button = event->button.button;
-
-        // SDL: 1=izq, 2=medio, 3=der. RmlUi usa 0=izq, 1=medio, 2=der
-        int rml_button = button - 1;
-
-        app->context->ProcessMouseButtonDown(rml_button, 0);
+    case SDL_EVENT_WINDOW_RESIZED:
+    case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+        // Before the scenes see the coalesced resize.
+        RefreshOutputSize(app);
         break;
-    }
-    case SDL_EVENT_MOUSE_BUTTON_UP:
-    {
-        int button = event->button.button;
-        int rml_button = button - 1;
-
-        app->context->ProcessMouseButtonUp(rml_button, 0);
+    case SDL_EVENT_LOW_MEMORY:
+        app->textures->Trim();
         break;
-    }
     case SDL_EVENT_KEY_DOWN:
-    {
-        const SDL_Keycode keycode = event->key.key;
-
-        // Convierte la tecla SDL a RmlUi
-        Rml::Input::KeyIdentifier rml_key = RmlSDL::ConvertKey(keycode);
-        app->context->ProcessKeyDown(rml_key, 0);
-
-        // Simula un Enter si hace falta para que dispare eventos "click"
-        if (keycode == SDLK_RETURN || keycode == SDLK_KP_ENTER)
-        {
-            app->context->ProcessTextInput("\n");
-        }
-
-        switch (event->key.scancode)
-        {
 #ifndef NDEBUG
-        case SDL_SCANCODE_F8:
+        if (event->key.scancode == SDL_SCANCODE_F8)
+        {
             SDL_LogDebug(SDL_LOG_CATEGORY_RENDER, "Changing visibility of Debugger");
             Rml::Debugger::SetVisible(!Rml::Debugger::IsVisible());
-            break;
+        }
+        if (event->key.scancode == SDL_SCANCODE_F6)
+        {
+            renderStatsOverlayVisible = !renderStatsOverlayVisible;
+        }
 #endif
-        default:
-            break;
+#ifdef CORE_TRACK_ALLOCATIONS
+        if (event->key.scancode == SDL_SCANCODE_F7)
+        {
+            allocationOverlayVisible = !allocationOverlayVisible;
         }
-    }
+#endif
+        break;
     default:
         break;
     }
 
+    // Everything else is dispatched once per frame, after redundant events are merged.
+    eventQueue.Push(*event);
+
+    return SDL_APP_CONTINUE;
+}
+
+static SDL_AppResult DispatchEvent(AppContext *app, SDL_Event *event)
+{
+    // Mouse, keyboard, text and window size go to RmlUi through the backend handler.
+    RmlSDL::InputEventHandler(app->context, app->window, *event);
+
     if (screenManager)
     {
         return HandleScreenEvents(event, screenManager, app);
@@ -252,12 +631,75 @@ SDL_AppResult SDL_AppIterate(void *appstate)
     currentTick = SDL_GetTicks();
     delta_time = (currentTick - lastTick) * .001f;
 
+    using core::memory::tracking::Phase;
+    using core::memory::tracking::PhaseScope;
+
+    SDL_AppResult eventResult;
+    {
+        PhaseScope phase{Phase::EVENTS};
+        eventResult = eventQueue.Drain([app](SDL_Event *event)
+                                       { return DispatchEvent(app, event); });
+    }
+    if (eventResult != SDL_APP_CONTINUE)
+    {
+        return eventResult;
+    }
+
+    // Work that other threads handed to the main thread, e.g. SDL video calls.
+    app->jobs->PumpMainThread();
+
+    // Publish this frame's input right before the scenes consume it.
+    app->input->BeginFrame();
+    app->svgs->Update();
+
     if (screenManager)
     {
-        screenManager->Update(delta_time);
-        screenManager->Render();
+        {
+            PhaseScope phase{Phase::UPDATE};
+            screenManager->Update(delta_time);
+        }
+        {
+            PhaseScope phase{Phase::RENDER};
+            screenManager->Render();
+        }
+    }
+
+#ifndef NDEBUG
+    if (renderStatsOverlayVisible)
+    {
+        PhaseScope phase{Phase::OVERLAY};
+        RenderStatsOverlay(app->renderQueue->Recording(), *app, app->outputHeight);
+    }
+#endif
+
+#ifdef CORE_TRACK_ALLOCATIONS
+    if (allocationOverlayVisible)
+    {
+        PhaseScope phase{Phase::OVERLAY};
+        RenderAllocationOverlay(app->renderQueue->Recording());
+    }
+#endif
+
+    {
+        PhaseScope phase{Phase::PRESENT};
+        app->renderQueue->Submit();
+    }
+    if (core::trace::MarkFirstFrame())
+    {
+        ReportStartup();
+    }
+
+    // Scene teardown and other dropped resources, a slice per frame once the frame is out.
+    {
+        PhaseScope phase{Phase::RELEASE};
+        app->releases->Run(releaseBudgetNS);
     }
 
+    // Everything allocated from the arena this frame has been consumed by now.
+    app->frameArena->Reset();
+    app->textures->EndFrame();
+    core::memory::tracking::EndFrame();
+
     return app->app_quit;
 }
 
@@ -266,21 +708,36 @@ void SDL_AppQuit(void *appstate, SDL_AppResult result)
     auto *app = (AppContext *)appstate;
     if (app)
     {
+        // Jobs still queued run here, and may use anything below.
+        delete app->jobs;
+        // Pending releases still need the audio mixer, the texture manager and the render queue.
+        delete app->releases;
+
+        // The render thread must be done with the renderer before it goes away.
+        app->renderQueue->StopThread();
         SDL_DestroyRenderer(app->renderer);
         SDL_DestroyWindow(app->window);
 
-        Mix_FadeOutMusic(1000); // prevent the music from abruptly ending.
-        Mix_CloseAudio();
+        delete app->music;
+        delete app->sfx;
         SDL_CloseAudioDevice(app->audioDevice);
         SDL_Log("Closing app");
         Rml::Shutdown();
         delete app->render_interface;
+        delete app->software_interface;
         delete app->system_interface;
+        delete app->file_interface;
+        delete app->svgs;
+        delete app->textures; // Also after Rml::Shutdown, which releases the UI textures
+        delete app->renderQueue; // After Rml::Shutdown, which still releases textures through it
+        delete app->frameArena;
+        delete app->input;
+        core::assets::Mount(nullptr);
+        delete app->assets;
 
         delete app;
     }
     // TTF_Quit();
-    Mix_Quit();
     SDL_Log("Application quit successfully!");
     SDL_Quit();
 }
\ No newline at end of file
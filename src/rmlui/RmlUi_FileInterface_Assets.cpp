@@ -0,0 +1,44 @@
+#include "RmlUi_FileInterface_Assets.h"
+#include "core/assets/AssetPack.h"
+#include <stdio.h>
+
+Rml::FileHandle FileInterface_Assets::Open(const Rml::String& path)
+{
+	// RmlUi probes optional files and reports the missing ones it needed itself.
+	SDL_IOStream* io = core::assets::OpenAsset(path);
+	if (!io)
+		SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open %s: %s", path.c_str(), SDL_GetError());
+	return reinterpret_cast<Rml::FileHandle>(io);
+}
+
+void FileInterface_Assets::Close(Rml::FileHandle file)
+{
+	SDL_CloseIO(reinterpret_cast<SDL_IOStream*>(file));
+}
+
+size_t FileInterface_Assets::Read(void* buffer, size_t size, Rml::FileHandle file)
+{
+	return SDL_ReadIO(reinterpret_cast<SDL_IOStream*>(file), buffer, size);
+}
+
+bool FileInterface_Assets::Seek(Rml::FileHandle file, long offset, int origin)
+{
+	SDL_IOWhence whence = SDL_IO_SEEK_SET;
+	if (origin == SEEK_CUR)
+		whence = SDL_IO_SEEK_CUR;
+	else if (origin == SEEK_END)
+		whence = SDL_IO_SEEK_END;
+	return SDL_SeekIO(reinterpret_cast<SDL_IOStream*>(file), offset, whence) >= 0;
+}
+
+size_t FileInterface_Assets::Tell(Rml::FileHandle file)
+{
+	const Sint64 position = SDL_TellIO(reinterpret_cast<SDL_IOStream*>(file));
+	return position < 0 ? 0 : (size_t)position;
+}
+
+size_t FileInterface_Assets::Length(Rml::FileHandle file)
+{
+	const Sint64 size = SDL_GetIOSize(reinterpret_cast<SDL_IOStream*>(file));
+	return size < 0 ? 0 : (size_t)size;
+}
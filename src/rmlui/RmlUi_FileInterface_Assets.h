@@ -0,0 +1,20 @@
+#ifndef RMLUI_BACKENDS_FILE_INTERFACE_ASSETS_H
+#define RMLUI_BACKENDS_FILE_INTERFACE_ASSETS_H
+
+#include <RmlUi/Core/FileInterface.h>
+#include <SDL3/SDL.h>
+
+// RmlUi file access through core::assets::OpenAsset(): documents, style sheets, fonts and images are read from the
+// mounted asset pack without copying, and from loose files when they are not packed. Handles are SDL_IOStreams.
+class FileInterface_Assets : public Rml::FileInterface {
+public:
+	Rml::FileHandle Open(const Rml::String& path) override;
+	void Close(Rml::FileHandle file) override;
+
+	size_t Read(void* buffer, size_t size, Rml::FileHandle file) override;
+	bool Seek(Rml::FileHandle file, long offset, int origin) override;
+	size_t Tell(Rml::FileHandle file) override;
+	size_t Length(Rml::FileHandle file) override;
+};
+
+#endif
@@ -27,9 +27,19 @@
  */
 
 #include "RmlUi_Renderer_SDL.h"
+#include "core/assets/AssetPack.h"
+#include "core/assets/CookedTexture.h"
+#include "core/render/CompactTextures.h"
+#include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Core.h>
 #include <RmlUi/Core/FileInterface.h>
+#include <RmlUi/Core/Log.h>
+#include <RmlUi/Core/Math.h>
 #include <RmlUi/Core/Types.h>
+#include <RmlUi/Core/Variant.h>
+#include <algorithm>
+#include <float.h>
+#include <string.h>
 
 #if SDL_MAJOR_VERSION >= 3
 	#include <SDL3_image/SDL_image.h>
@@ -58,16 +68,55 @@ static void SetRenderViewport(SDL_Renderer* renderer, const SDL_Rect* rect)
 #endif
 }
 
-RenderInterface_SDL::RenderInterface_SDL(SDL_Renderer* renderer) : renderer(renderer)
+RenderInterface_SDL::RenderInterface_SDL(SDL_Renderer* renderer) : renderer(renderer), target_pool(renderer, nullptr)
 {
 	// RmlUi serves vertex colors and textures with premultiplied alpha, set the blend mode accordingly.
 	// Equivalent to glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA).
 	blend_mode = SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD, SDL_BLENDFACTOR_ONE,
 		SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+
+	// Scales the destination by the source alpha: applies masks without shaders or a stencil buffer.
+	mask_blend_mode = SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ZERO, SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDOPERATION_ADD, SDL_BLENDFACTOR_ZERO,
+		SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+
+	// Replaces the destination color by the source color, keeping the destination coverage: tints drop shadows.
+	shadow_blend_mode = SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_DST_ALPHA, SDL_BLENDFACTOR_ZERO, SDL_BLENDOPERATION_ADD, SDL_BLENDFACTOR_DST_ALPHA,
+		SDL_BLENDFACTOR_ZERO, SDL_BLENDOPERATION_ADD);
+
+	layers.push_back(nullptr);
+}
+
+RenderInterface_SDL::~RenderInterface_SDL()
+{
+	if (clip_mask)
+		target_pool.Release(clip_mask);
+	TrimGeneratedTextures(-1);
+}
+
+void RenderInterface_SDL::SetRenderQueue(core::render::RenderQueue* queue)
+{
+	render_queue = queue;
+	target_pool.SetQueue(queue);
 }
 
 void RenderInterface_SDL::BeginFrame()
 {
+	frame_index++;
+	layers.assign(1, nullptr);
+	layer_width = layer_height = 0;
+	cull_stats = {};
+	path_stats = {};
+
+	if (render_queue)
+	{
+		core::render::CommandBuffer& commands = render_queue->Recording();
+		commands.SetViewport(nullptr);
+		commands.SetDrawColor(0, 0, 0, 255);
+		commands.Clear();
+		commands.SetDrawBlendMode(blend_mode);
+		return;
+	}
+
 	SetRenderViewport(renderer, nullptr);
 	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
 	SDL_RenderClear(renderer);
@@ -76,9 +125,79 @@ void RenderInterface_SDL::BeginFrame()
 
 void RenderInterface_SDL::EndFrame() {}
 
+// Matches the quads RmlUi generates for boxes and glyphs: four vertices on the corners of their bounding box, one color,
+// texture coordinates following the corners, and two triangles split along a diagonal.
+static bool IsAxisAlignedQuad(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices, Rml::Vector2f min, Rml::Vector2f max,
+	Rml::Vector2f& uv_min, Rml::Vector2f& uv_max)
+{
+	if (vertices.size() != 4 || indices.size() != 6 || min.x >= max.x || min.y >= max.y)
+		return false;
+
+	// Corner bits: 1 for the right edge, 2 for the bottom edge.
+	int corner_of_vertex[4];
+	int vertex_of_corner[4] = {-1, -1, -1, -1};
+	for (int i = 0; i < 4; i++)
+	{
+		const Rml::Vertex& vertex = vertices[i];
+		if ((vertex.position.x != min.x && vertex.position.x != max.x) || (vertex.position.y != min.y && vertex.position.y != max.y))
+			return false;
+		if (vertex.colour != vertices[0].colour)
+			return false;
+
+		const int corner = (vertex.position.x == max.x ? 1 : 0) | (vertex.position.y == max.y ? 2 : 0);
+		if (vertex_of_corner[corner] != -1)
+			return false;
+		vertex_of_corner[corner] = i;
+		corner_of_vertex[i] = corner;
+	}
+
+	uv_min = vertices[vertex_of_corner[0]].tex_coord;
+	uv_max = vertices[vertex_of_corner[3]].tex_coord;
+	if (uv_min.x > uv_max.x || uv_min.y > uv_max.y)
+		return false;
+	for (int i = 0; i < 4; i++)
+	{
+		const Rml::Vector2f expected = {(corner_of_vertex[i] & 1) ? uv_max.x : uv_min.x, (corner_of_vertex[i] & 2) ? uv_max.y : uv_min.y};
+		if (vertices[i].tex_coord != expected)
+			return false;
+	}
+
+	// Each triangle leaves out one corner; the two left out must be opposite for the triangles to cover the box.
+	int missing_corner[2];
+	for (int t = 0; t < 2; t++)
+	{
+		int corner_sum = 0 + 1 + 2 + 3;
+		int used = 0;
+		for (int k = 0; k < 3; k++)
+		{
+			const int index = indices[t * 3 + k];
+			if (index < 0 || index > 3 || (used & (1 << corner_of_vertex[index])))
+				return false;
+			used |= 1 << corner_of_vertex[index];
+			corner_sum -= corner_of_vertex[index];
+		}
+		missing_corner[t] = corner_sum;
+	}
+	return missing_corner[0] == (missing_corner[1] ^ 3);
+}
+
 Rml::CompiledGeometryHandle RenderInterface_SDL::CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices)
 {
-	GeometryView* data = new GeometryView{vertices, indices};
+	GeometryView* data = new GeometryView{vertices, indices, next_geometry_id++, {}, {}};
+
+	if (!vertices.empty())
+	{
+		data->min = data->max = vertices[0].position;
+		for (const Rml::Vertex& vertex : vertices)
+		{
+			data->min = Rml::Math::Min(data->min, vertex.position);
+			data->max = Rml::Math::Max(data->max, vertex.position);
+		}
+	}
+
+	data->is_quad = IsAxisAlignedQuad(vertices, indices, data->min, data->max, data->uv_min, data->uv_max);
+	if (data->is_quad)
+		data->quad_colour = vertices[0].colour;
 	return reinterpret_cast<Rml::CompiledGeometryHandle>(data);
 }
 
@@ -87,37 +206,128 @@ void RenderInterface_SDL::ReleaseGeometry(Rml::CompiledGeometryHandle geometry)
 	delete reinterpret_cast<GeometryView*>(geometry);
 }
 
-void RenderInterface_SDL::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture)
+void RenderInterface_SDL::ConvertVertices(const GeometryView* geometry, Rml::Vector2f translation, const SDL_FColor* forced_color,
+	SDL_Vertex* out) const
 {
-	const GeometryView* geometry = reinterpret_cast<GeometryView*>(handle);
 	const Rml::Vertex* vertices = geometry->vertices.data();
 	const size_t num_vertices = geometry->vertices.size();
-	const int* indices = geometry->indices.data();
-	const size_t num_indices = geometry->indices.size();
-
-	Rml::UniquePtr<SDL_Vertex[]> sdl_vertices{new SDL_Vertex[num_vertices]};
 
 	for (size_t i = 0; i < num_vertices; i++)
 	{
-		sdl_vertices[i].position = {vertices[i].position.x + translation.x, vertices[i].position.y + translation.y};
-		sdl_vertices[i].tex_coord = {vertices[i].tex_coord.x, vertices[i].tex_coord.y};
+		Rml::Vector2f position = vertices[i].position + translation;
+		if (transform_enabled)
+		{
+			// Transforms are applied on the CPU: SDL_RenderGeometry only takes 2D positions.
+			const Rml::Vector4f projected = transform * Rml::Vector4f(position.x, position.y, 0.f, 1.f);
+			const float w = (projected.w != 0.f ? projected.w : 1.f);
+			position = {projected.x / w, projected.y / w};
+		}
+		out[i].position = {position.x, position.y};
+		out[i].tex_coord = {vertices[i].tex_coord.x, vertices[i].tex_coord.y};
+
+		if (forced_color)
+		{
+			out[i].color = *forced_color;
+			continue;
+		}
 
 		const auto& color = vertices[i].colour;
 #if SDL_MAJOR_VERSION >= 3
-		sdl_vertices[i].color = {color.red / 255.f, color.green / 255.f, color.blue / 255.f, color.alpha / 255.f};
+		out[i].color = {color.red / 255.f, color.green / 255.f, color.blue / 255.f, color.alpha / 255.f};
 #else
-		sdl_vertices[i].color = {color.red, color.green, color.blue, color.alpha};
+		out[i].color = {color.red, color.green, color.blue, color.alpha};
 #endif
 	}
+}
 
-	SDL_Texture* sdl_texture = (SDL_Texture*)texture;
+void RenderInterface_SDL::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture)
+{
+	const GeometryView* geometry = reinterpret_cast<GeometryView*>(handle);
+	const size_t num_vertices = geometry->vertices.size();
+	const int* indices = geometry->indices.data();
+	const size_t num_indices = geometry->indices.size();
 
-	SDL_RenderGeometry(renderer, sdl_texture, sdl_vertices.get(), (int)num_vertices, indices, (int)num_indices);
+	cull_stats.draws++;
+	if (IsCulled(geometry, translation))
+	{
+		cull_stats.culled_draws++;
+		cull_stats.culled_vertices += num_vertices;
+		return;
+	}
+
+	// Resolved after culling, so that evicted textures are only reloaded once they are visible again.
+	SDL_Texture* sdl_texture = GetTexture(texture);
+
+	if (ui_capture)
+	{
+		HashUi(&geometry->id, sizeof(geometry->id));
+		HashUi(&translation, sizeof(translation));
+		HashUi(&texture, sizeof(texture));
+	}
+
+	if (clip_mask_enabled && clip_mask)
+	{
+		// Draw alone into a scratch target, cut it with the mask, then composite onto the current layer.
+		SDL_Texture* scratch = AcquireLayerTarget();
+		if (!scratch)
+			return;
+
+		core::render::CommandBuffer& commands = Recorder();
+		SetTarget(commands, scratch, true);
+		commands.SetDrawColor(0, 0, 0, 0);
+		commands.Clear();
+		ConvertVertices(geometry, translation, nullptr, commands.Geometry(sdl_texture, (int)num_vertices, indices, (int)num_indices));
+		Blit(commands, clip_mask, scratch, mask_blend_mode);
+		SetTarget(commands, layers.back(), true);
+		commands.SetTextureBlendMode(scratch, blend_mode);
+		commands.Texture(scratch, nullptr, nullptr);
+		target_pool.Release(scratch);
+		FlushImmediate();
+		return;
+	}
+
+	if (quad_fast_path_enabled && geometry->is_quad && !transform_enabled)
+	{
+		DrawQuad(Commands(), geometry, translation, sdl_texture);
+		return;
+	}
+	path_stats.meshes++;
+
+	// Vertices are converted straight into the command buffer when recording. Otherwise they are
+	// scratch: from the frame arena when available, or from a reused buffer.
+	if (core::render::CommandBuffer* commands = Commands())
+	{
+		ConvertVertices(geometry, translation, nullptr, commands->Geometry(sdl_texture, (int)num_vertices, indices, (int)num_indices));
+		return;
+	}
+
+	SDL_Vertex* sdl_vertices = nullptr;
+	if (frame_arena)
+	{
+		sdl_vertices = frame_arena->AllocateArray<SDL_Vertex>(num_vertices);
+	}
+	else
+	{
+		if (vertex_scratch.size() < num_vertices)
+			vertex_scratch.resize(num_vertices);
+		sdl_vertices = vertex_scratch.data();
+	}
+
+	ConvertVertices(geometry, translation, nullptr, sdl_vertices);
+	SDL_RenderGeometry(renderer, sdl_texture, sdl_vertices, (int)num_vertices, indices, (int)num_indices);
 }
 
 void RenderInterface_SDL::EnableScissorRegion(bool enable)
 {
-	if (enable)
+	if (ui_capture)
+	{
+		HashUi(&enable, sizeof(enable));
+		HashUi(&rect_scissor, sizeof(rect_scissor));
+	}
+
+	if (core::render::CommandBuffer* commands = Commands())
+		commands->SetClipRect(enable ? &rect_scissor : nullptr);
+	else if (enable)
 		SetRenderClipRect(renderer, &rect_scissor);
 	else
 		SetRenderClipRect(renderer, nullptr);
@@ -133,34 +343,71 @@ void RenderInterface_SDL::SetScissorRegion(Rml::Rectanglei region)
 	rect_scissor.h = region.Height();
 
 	if (scissor_region_enabled)
-		SetRenderClipRect(renderer, &rect_scissor);
+	{
+		if (ui_capture)
+			HashUi(&rect_scissor, sizeof(rect_scissor));
+
+		if (core::render::CommandBuffer* commands = Commands())
+			commands->SetClipRect(&rect_scissor);
+		else
+			SetRenderClipRect(renderer, &rect_scissor);
+	}
 }
 
 Rml::TextureHandle RenderInterface_SDL::LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source)
 {
-	Rml::FileInterface* file_interface = Rml::GetFileInterface();
-	Rml::FileHandle file_handle = file_interface->Open(source);
-	if (!file_handle)
+	SDL_Texture* texture = CreateTextureFromFile(source, texture_dimensions);
+	if (!texture)
 		return {};
 
-	file_interface->Seek(file_handle, 0, SEEK_END);
-	size_t buffer_size = file_interface->Tell(file_handle);
-	file_interface->Seek(file_handle, 0, SEEK_SET);
+	return AddTexture(texture, [this, source]() {
+		Rml::Vector2i dimensions;
+		return CreateTextureFromFile(source, dimensions);
+	});
+}
 
+SDL_Texture* RenderInterface_SDL::CreateTextureFromFile(const Rml::String& source, Rml::Vector2i& texture_dimensions)
+{
 	using Rml::byte;
-	Rml::UniquePtr<byte[]> buffer(new byte[buffer_size]);
-	file_interface->Read(buffer.get(), buffer_size, file_handle);
-	file_interface->Close(file_handle);
-
 	const size_t i_ext = source.rfind('.');
 	Rml::String extension = (i_ext == Rml::String::npos ? Rml::String() : source.substr(i_ext + 1));
 
 #if SDL_MAJOR_VERSION >= 3
-	auto CreateSurface = [&]() { return IMG_LoadTyped_IO(SDL_IOFromMem(buffer.get(), int(buffer_size)), 1, extension.c_str()); };
+	// Images cooked at build time are uploaded as they are, already decoded and premultiplied.
+	core::assets::CookedTexture cooked;
+	if (cooked.Open(source))
+	{
+		core::render::RenderLock lock(render_queue);
+		texture_generation++;
+		SDL_Texture* texture = cooked.CreateTexture(renderer);
+		texture_dimensions = {cooked.GetWidth(), cooked.GetHeight()};
+		if (texture)
+			SDL_SetTextureBlendMode(texture, blend_mode);
+		return texture;
+	}
+
+	// Decoded straight from the asset pack mapping, or streamed from the loose file, without an intermediate buffer.
+	auto CreateSurface = [&]() -> SDL_Surface* {
+		SDL_IOStream* io = core::assets::OpenAsset(source);
+		return io ? IMG_LoadTyped_IO(io, true, extension.c_str()) : nullptr;
+	};
 	auto GetSurfaceFormat = [](SDL_Surface* surface) { return surface->format; };
 	auto ConvertSurface = [](SDL_Surface* surface, SDL_PixelFormat format) { return SDL_ConvertSurface(surface, format); };
 	auto DestroySurface = [](SDL_Surface* surface) { SDL_DestroySurface(surface); };
 #else
+	Rml::FileInterface* file_interface = Rml::GetFileInterface();
+	Rml::FileHandle file_handle = file_interface->Open(source);
+	if (!file_handle)
+		return nullptr;
+
+	file_interface->Seek(file_handle, 0, SEEK_END);
+	size_t buffer_size = file_interface->Tell(file_handle);
+	file_interface->Seek(file_handle, 0, SEEK_SET);
+
+	Rml::UniquePtr<byte[]> buffer(new byte[buffer_size]);
+	file_interface->Read(buffer.get(), buffer_size, file_handle);
+	file_interface->Close(file_handle);
+
 	auto CreateSurface = [&]() { return IMG_LoadTyped_RW(SDL_RWFromMem(buffer.get(), int(buffer_size)), 1, extension.c_str()); };
 	auto GetSurfaceFormat = [](SDL_Surface* surface) { return surface->format->format; };
 	auto ConvertSurface = [](SDL_Surface* surface, Uint32 format) { return SDL_ConvertSurfaceFormat(surface, format, 0); };
@@ -169,8 +416,10 @@ Rml::TextureHandle RenderInterface_SDL::LoadTexture(Rml::Vector2i& texture_dimen
 
 	SDL_Surface* surface = CreateSurface();
 	if (!surface)
-		return {};
+		return nullptr;
 
+	core::render::RenderLock lock(render_queue);
+	texture_generation++;
 	texture_dimensions = {surface->w, surface->h};
 
 	if (GetSurfaceFormat(surface) != SDL_PIXELFORMAT_RGBA32 && GetSurfaceFormat(surface) != SDL_PIXELFORMAT_BGRA32)
@@ -178,7 +427,7 @@ Rml::TextureHandle RenderInterface_SDL::LoadTexture(Rml::Vector2i& texture_dimen
 		SDL_Surface* converted_surface = ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
 		DestroySurface(surface);
 		if (!converted_surface)
-			return {};
+			return nullptr;
 
 		surface = converted_surface;
 	}
@@ -193,43 +442,795 @@ Rml::TextureHandle RenderInterface_SDL::LoadTexture(Rml::Vector2i& texture_dimen
 			pixels[i + j] = byte(int(pixels[i + j]) * int(alpha) / 255);
 	}
 
+#if SDL_MAJOR_VERSION >= 3
+	SDL_Texture* texture = GetSurfaceFormat(surface) == SDL_PIXELFORMAT_RGBA32
+		? core::render::compact::CreateTexture(renderer, pixels, surface->w, surface->h, surface->pitch)
+		: SDL_CreateTextureFromSurface(renderer, surface);
+#else
 	SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+#endif
 	texture_dimensions = Rml::Vector2i(surface->w, surface->h);
 	DestroySurface(surface);
 
 	if (texture)
 		SDL_SetTextureBlendMode(texture, blend_mode);
 
-	return (Rml::TextureHandle)texture;
+	return texture;
 }
 
 Rml::TextureHandle RenderInterface_SDL::GenerateTexture(Rml::Span<const Rml::byte> source, Rml::Vector2i source_dimensions)
 {
 	RMLUI_ASSERT(source.data() && source.size() == size_t(source_dimensions.x * source_dimensions.y * 4));
+	texture_generation++;
 
-#if SDL_MAJOR_VERSION >= 3
-	auto CreateSurface = [&]() {
-		return SDL_CreateSurfaceFrom(source_dimensions.x, source_dimensions.y, SDL_PIXELFORMAT_RGBA32, (void*)source.data(), source_dimensions.x * 4);
+	// Font atlases hold white glyphs, their coverage alone fits a compact format.
+	const SDL_PixelFormat format =
+		core::render::compact::ChooseAlphaOnlyFormat(renderer, source.data(), source_dimensions.x, source_dimensions.y, source_dimensions.x * 4);
+
+	// A released texture can be patched once the frames that drew it are replayed: the one recording it and, with a
+	// render thread, the one in flight.
+	for (GeneratedTexture& generated : generated_textures)
+	{
+		if (generated.released_frame && frame_index >= generated.released_frame + 2 && generated.width == source_dimensions.x &&
+			generated.height == source_dimensions.y && generated.format == format)
+		{
+			UploadGeneratedTexture(GetTexture(generated.handle), source, generated.width, generated.pixels.data(), generated.height);
+			memcpy(generated.pixels.data(), source.data(), source.size());
+			generated.released_frame = 0;
+			generated_stats.reused++;
+			return generated.handle;
+		}
+	}
+
+	SDL_Texture* texture = nullptr;
+	{
+		core::render::RenderLock lock(render_queue);
+		texture = SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_STREAMING, source_dimensions.x, source_dimensions.y);
+	}
+	if (!texture)
+	{
+		SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Couldn't create a %dx%d generated texture: %s", source_dimensions.x, source_dimensions.y,
+			SDL_GetError());
+		return {};
+	}
+	SDL_SetTextureBlendMode(texture, blend_mode);
+	UploadGeneratedTexture(texture, source, source_dimensions.x, nullptr, source_dimensions.y);
+	generated_stats.created++;
+
+	// Font atlases and other generated textures can't be recreated on demand, they stay resident.
+	const Rml::TextureHandle handle = AddTexture(texture, {});
+	generated_textures.push_back({handle, source_dimensions.x, source_dimensions.y, format, Rml::Vector<Rml::byte>(source.begin(), source.end()), 0});
+	return handle;
+}
+
+void RenderInterface_SDL::UploadGeneratedTexture(SDL_Texture* texture, Rml::Span<const Rml::byte> source, int width, const Rml::byte* previous,
+	int height)
+{
+	const int pitch = width * 4;
+	SDL_Rect dirty = {0, 0, width, height};
+
+	if (previous)
+	{
+		// Bounding box of the pixels that changed. Glyphs added to an atlas usually touch a few rows only.
+		int x0 = width, x1 = 0, y0 = height, y1 = 0;
+		for (int y = 0; y < height; y++)
+		{
+			const Rml::byte* row = source.data() + (size_t)y * pitch;
+			const Rml::byte* old_row = previous + (size_t)y * pitch;
+			if (memcmp(row, old_row, pitch) == 0)
+				continue;
+
+			int left = 0, right = width;
+			while (memcmp(row + left * 4, old_row + left * 4, 4) == 0)
+				left++;
+			while (memcmp(row + (right - 1) * 4, old_row + (right - 1) * 4, 4) == 0)
+				right--;
+			x0 = Rml::Math::Min(x0, left);
+			x1 = Rml::Math::Max(x1, right);
+			y0 = Rml::Math::Min(y0, y);
+			y1 = y + 1;
+		}
+		if (y0 >= y1)
+			return;
+		dirty = {x0, y0, x1 - x0, y1 - y0};
+	}
+
+	core::render::RenderLock lock(render_queue);
+	core::render::compact::UpdateTexture(texture, &dirty, source.data() + (size_t)dirty.y * pitch + dirty.x * 4, pitch);
+	generated_stats.uploaded += (Uint64)dirty.w * dirty.h * SDL_BYTESPERPIXEL(texture->format);
+}
+
+void RenderInterface_SDL::TrimGeneratedTextures(int max_idle_frames)
+{
+	for (GeneratedTexture& generated : generated_textures)
+	{
+		if (generated.released_frame && (max_idle_frames < 0 || frame_index - generated.released_frame > (Uint64)max_idle_frames))
+		{
+			DestroyTexture(generated.handle);
+			generated.handle = {};
+		}
+	}
+	generated_textures.erase(std::remove_if(generated_textures.begin(), generated_textures.end(),
+								 [](const GeneratedTexture& generated) { return !generated.handle; }),
+		generated_textures.end());
+}
+
+void RenderInterface_SDL::ReleaseTexture(Rml::TextureHandle texture_handle)
+{
+	texture_generation++;
+
+	// Generated textures are kept for reuse and destroyed by TrimGeneratedTextures().
+	for (GeneratedTexture& generated : generated_textures)
+	{
+		if (generated.handle == texture_handle)
+		{
+			generated.released_frame = frame_index;
+			return;
+		}
+	}
+
+	// Recorded geometry may still reference the texture.
+	if (ui_capture)
+		ui_deferred_releases.push_back(texture_handle);
+	else
+		DestroyTexture(texture_handle);
+}
+
+SDL_Texture* RenderInterface_SDL::GetTexture(Rml::TextureHandle texture_handle)
+{
+	if (!texture_manager)
+		return (SDL_Texture*)texture_handle;
+	return texture_handle ? texture_manager->Get((core::render::TextureId)texture_handle) : nullptr;
+}
+
+Rml::TextureHandle RenderInterface_SDL::AddTexture(SDL_Texture* texture, core::render::TextureManager::Loader reload)
+{
+	if (!texture_manager || !texture)
+		return (Rml::TextureHandle)texture;
+	return (Rml::TextureHandle)texture_manager->Add(texture, "ui", std::move(reload));
+}
+
+void RenderInterface_SDL::DestroyTexture(Rml::TextureHandle texture_handle)
+{
+	if (texture_manager)
+		texture_manager->Release((core::render::TextureId)texture_handle);
+	else if (render_queue)
+		render_queue->DestroyTexture((SDL_Texture*)texture_handle);
+	else
+		SDL_DestroyTexture((SDL_Texture*)texture_handle);
+}
+
+core::render::CommandBuffer* RenderInterface_SDL::Commands()
+{
+	if (ui_capture)
+		return &ui_commands;
+	return render_queue ? &render_queue->Recording() : nullptr;
+}
+
+core::render::CommandBuffer& RenderInterface_SDL::Recorder()
+{
+	// Offscreen passes are always recorded; without a queue they are replayed right away by FlushImmediate().
+	core::render::CommandBuffer* commands = Commands();
+	return commands ? *commands : immediate_commands;
+}
+
+void RenderInterface_SDL::FlushImmediate()
+{
+	if (Commands() || immediate_commands.IsEmpty())
+		return;
+	immediate_commands.Replay(renderer);
+	immediate_commands.Reset();
+}
+
+void RenderInterface_SDL::HashUi(const void* data, size_t size)
+{
+	// FNV-1a
+	const Rml::byte* bytes = static_cast<const Rml::byte*>(data);
+	for (size_t i = 0; i < size; i++)
+	{
+		ui_hash ^= bytes[i];
+		ui_hash *= 0x100000001b3ull;
+	}
+}
+
+bool RenderInterface_SDL::EnsureUiCache(int width, int height)
+{
+	if (ui_cache && ui_cache_width == width && ui_cache_height == height)
+		return true;
+
+	if (ui_cache)
+	{
+		render_queue->DestroyTexture(ui_cache);
+		ui_cache = nullptr;
+	}
+
+	core::render::RenderLock lock(render_queue);
+	ui_cache = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, width, height);
+	if (!ui_cache)
+	{
+		SDL_LogError(SDL_LOG_CATEGORY_RENDER, "UI cache disabled, couldn't create a %dx%d target: %s", width, height, SDL_GetError());
+		ui_cache_enabled = false;
+		return false;
+	}
+	// The cached pixels are premultiplied like everything else RmlUi renders.
+	SDL_SetTextureBlendMode(ui_cache, blend_mode);
+	ui_cache_width = width;
+	ui_cache_height = height;
+	return true;
+}
+
+void RenderInterface_SDL::RenderContext(Rml::Context* context)
+{
+	frame_index++;
+	TrimGeneratedTextures(120);
+	layers.assign(1, nullptr);
+	layer_width = layer_height = 0;
+	cull_stats = {};
+	path_stats = {};
+
+	if (!render_queue || !ui_cache_enabled)
+	{
+		context->Render();
+		EndLayers();
+		return;
+	}
+
+	// Capture the whole UI and fingerprint it: geometry is immutable once compiled, so the same geometry ids,
+	// translations, textures and scissor regions produce the same pixels.
+	ui_commands.Reset();
+	ui_hash = 0xcbf29ce484222325ull;
+	if (scissor_region_enabled)
+	{
+		ui_commands.SetClipRect(&rect_scissor);
+		HashUi(&rect_scissor, sizeof(rect_scissor));
+	}
+
+	ui_capture = true;
+	context->Render();
+	ui_capture = false;
+
+	int width = 0, height = 0;
+	render_queue->GetOutputSize(&width, &height);
+	HashUi(&width, sizeof(width));
+	HashUi(&height, sizeof(height));
+	HashUi(&texture_generation, sizeof(texture_generation));
+
+	core::render::CommandBuffer& commands = render_queue->Recording();
+	if (ui_commands.IsEmpty())
+	{
+		// Nothing visible
+	}
+	else if (ui_cache && ui_hash == ui_cached_hash && width == ui_cache_width && height == ui_cache_height)
+	{
+		ui_cache_stats.hits++;
+		commands.Texture(ui_cache, nullptr, nullptr);
+	}
+	else if (ui_hash == ui_last_hash && EnsureUiCache(width, height))
+	{
+		// Unchanged for two frames in a row: worth caching.
+		ui_cache_stats.rebuilds++;
+		commands.SetRenderTarget(ui_cache);
+		commands.SetDrawColor(0, 0, 0, 0);
+		commands.Clear();
+		commands.Append(ui_commands, ui_cache);
+		commands.SetClipRect(nullptr);
+		commands.SetRenderTarget(nullptr);
+		commands.Texture(ui_cache, nullptr, nullptr);
+		ui_cached_hash = ui_hash;
+	}
+	else
+	{
+		// Animating or just changed: a cache rebuild every frame would only add a pass.
+		ui_cache_stats.bypassed++;
+		commands.Append(ui_commands);
+		commands.SetClipRect(nullptr);
+	}
+	ui_last_hash = ui_hash;
+
+	for (Rml::TextureHandle texture : ui_deferred_releases)
+		DestroyTexture(texture);
+	ui_deferred_releases.clear();
+
+	EndLayers();
+}
+
+void RenderInterface_SDL::SetTarget(core::render::CommandBuffer& commands, SDL_Texture* target, bool clip)
+{
+	// Clip rectangles belong to the target in SDL, so they are set again after every switch.
+	commands.SetRenderTarget(target);
+	commands.SetClipRect(clip && scissor_region_enabled ? &rect_scissor : nullptr);
+}
+
+void RenderInterface_SDL::Blit(core::render::CommandBuffer& commands, SDL_Texture* source, SDL_Texture* destination, SDL_BlendMode mode)
+{
+	SetTarget(commands, destination, false);
+	commands.SetTextureBlendMode(source, mode);
+	commands.SetTextureMod(source, 255, 255, 255, 255);
+	commands.Texture(source, nullptr, nullptr);
+}
+
+void RenderInterface_SDL::Blur(core::render::CommandBuffer& commands, SDL_Texture* texture, float sigma)
+{
+	// Approximates a gaussian by halving the texture with linear filtering until the remaining sigma is about one pixel,
+	// then scaling back up. Every level is a pooled target, so a steady blur allocates nothing.
+	constexpr int max_levels = 5;
+	SDL_Texture* levels[max_levels + 1] = {texture};
+	int width = layer_width;
+	int height = layer_height;
+	int num_levels = 0;
+
+	for (float remaining = sigma; remaining > 0.5f && num_levels < max_levels; remaining *= 0.5f)
+	{
+		width = Rml::Math::Max(width / 2, 1);
+		height = Rml::Math::Max(height / 2, 1);
+		SDL_Texture* level = target_pool.Acquire(width, height);
+		if (!level)
+			break;
+
+		Blit(commands, levels[num_levels], level, SDL_BLENDMODE_NONE);
+		levels[++num_levels] = level;
+	}
+
+	for (int i = num_levels; i > 0; i--)
+	{
+		Blit(commands, levels[i], levels[i - 1], SDL_BLENDMODE_NONE);
+		target_pool.Release(levels[i]);
+	}
+}
+
+bool RenderInterface_SDL::IsCulled(const GeometryView* geometry, Rml::Vector2f translation)
+{
+	if (geometry->vertices.empty())
+		return true;
+
+	// A transformed box is no longer axis-aligned, such geometry is always drawn.
+	if (transform_enabled)
+		return false;
+
+	UpdateLayerSize();
+	float left = 0.f, top = 0.f, right = FLT_MAX, bottom = FLT_MAX;
+	if (layer_width > 0 && layer_height > 0)
+	{
+		right = (float)layer_width;
+		bottom = (float)layer_height;
+	}
+	if (scissor_region_enabled)
+	{
+		left = Rml::Math::Max(left, (float)rect_scissor.x);
+		top = Rml::Math::Max(top, (float)rect_scissor.y);
+		right = Rml::Math::Min(right, (float)(rect_scissor.x + rect_scissor.w));
+		bottom = Rml::Math::Min(bottom, (float)(rect_scissor.y + rect_scissor.h));
+	}
+
+	const Rml::Vector2f min = geometry->min + translation;
+	const Rml::Vector2f max = geometry->max + translation;
+	return max.x <= left || max.y <= top || min.x >= right || min.y >= bottom;
+}
+
+void RenderInterface_SDL::DrawQuad(core::render::CommandBuffer* commands, const GeometryView* geometry, Rml::Vector2f translation,
+	SDL_Texture* texture)
+{
+	const Rml::ColourbPremultiplied& colour = geometry->quad_colour;
+	const Rml::Vector2f size = geometry->max - geometry->min;
+	const SDL_FRect rect = {geometry->min.x + translation.x, geometry->min.y + translation.y, size.x, size.y};
+
+	if (!texture)
+	{
+		// The colour is premultiplied, so the rect needs the same blend mode as the geometry path. Nothing else sets
+		// the draw blend mode reliably: BeginFrame() isn't called by the scenes, and SDL defaults to straight alpha.
+		path_stats.solid_rects++;
+		if (commands)
+		{
+			commands->SetDrawBlendMode(blend_mode);
+			commands->SetDrawColor(colour.red, colour.green, colour.blue, colour.alpha);
+			commands->FillRect(&rect);
+		}
+		else
+		{
+			SDL_SetRenderDrawBlendMode(renderer, blend_mode);
+			SDL_SetRenderDrawColor(renderer, colour.red, colour.green, colour.blue, colour.alpha);
+			SDL_RenderFillRect(renderer, &rect);
+		}
+		return;
+	}
+
+	path_stats.textured_quads++;
+	float texture_width = 0.f, texture_height = 0.f;
+	SDL_GetTextureSize(texture, &texture_width, &texture_height);
+	const Rml::Vector2f uv_size = geometry->uv_max - geometry->uv_min;
+	const SDL_FRect source = {geometry->uv_min.x * texture_width, geometry->uv_min.y * texture_height, uv_size.x * texture_width,
+		uv_size.y * texture_height};
+
+	// Vertex colors modulate the texture, which a copy expresses as color and alpha modulation. Textures are shared
+	// (e.g. font atlases), so a tint is undone right after the draw.
+	const bool tinted = (colour != Rml::ColourbPremultiplied(255, 255, 255, 255));
+	if (commands)
+	{
+		if (tinted)
+			commands->SetTextureMod(texture, colour.red, colour.green, colour.blue, colour.alpha);
+		commands->Texture(texture, &source, &rect);
+		if (tinted)
+			commands->SetTextureMod(texture, 255, 255, 255, 255);
+	}
+	else
+	{
+		if (tinted)
+		{
+			SDL_SetTextureColorMod(texture, colour.red, colour.green, colour.blue);
+			SDL_SetTextureAlphaMod(texture, colour.alpha);
+		}
+		SDL_RenderTexture(renderer, texture, &source, &rect);
+		if (tinted)
+		{
+			SDL_SetTextureColorMod(texture, 255, 255, 255);
+			SDL_SetTextureAlphaMod(texture, 255);
+		}
+	}
+}
+
+void RenderInterface_SDL::UpdateLayerSize()
+{
+	// Layers, masks and culling all use the output size, queried once per frame.
+	if (layer_width != 0 && layer_height != 0)
+		return;
+
+	if (render_queue)
+		render_queue->GetOutputSize(&layer_width, &layer_height);
+	else
+		SDL_GetCurrentRenderOutputSize(renderer, &layer_width, &layer_height);
+}
+
+SDL_Texture* RenderInterface_SDL::AcquireLayerTarget()
+{
+	UpdateLayerSize();
+	return target_pool.Acquire(layer_width, layer_height);
+}
+
+void RenderInterface_SDL::EndLayers()
+{
+	if (clip_mask)
+	{
+		target_pool.Release(clip_mask);
+		clip_mask = nullptr;
+	}
+	clip_mask_enabled = false;
+	target_pool.EndFrame();
+}
+
+void RenderInterface_SDL::EnableClipMask(bool enable)
+{
+	if (ui_capture)
+		HashUi(&enable, sizeof(enable));
+
+	clip_mask_enabled = enable;
+}
+
+void RenderInterface_SDL::RenderToClipMask(Rml::ClipMaskOperation operation, Rml::CompiledGeometryHandle handle, Rml::Vector2f translation)
+{
+	const GeometryView* geometry = reinterpret_cast<GeometryView*>(handle);
+	const int num_vertices = (int)geometry->vertices.size();
+	const int* indices = geometry->indices.data();
+	const int num_indices = (int)geometry->indices.size();
+
+	if (ui_capture)
+	{
+		HashUi(&operation, sizeof(operation));
+		HashUi(&geometry->id, sizeof(geometry->id));
+		HashUi(&translation, sizeof(translation));
+	}
+
+	if (!clip_mask && !(clip_mask = AcquireLayerTarget()))
+		return;
+
+	// The mask lives in the alpha channel: opaque where drawing is allowed.
+	const SDL_FColor inside = {1.f, 1.f, 1.f, 1.f};
+	const SDL_FColor outside = {0.f, 0.f, 0.f, 0.f};
+	core::render::CommandBuffer& commands = Recorder();
+
+	switch (operation)
+	{
+	case Rml::ClipMaskOperation::Set:
+	case Rml::ClipMaskOperation::SetInverse:
+	{
+		const bool inverse = (operation == Rml::ClipMaskOperation::SetInverse);
+		SetTarget(commands, clip_mask, true);
+		commands.SetDrawColor(inverse ? 255 : 0, inverse ? 255 : 0, inverse ? 255 : 0, inverse ? 255 : 0);
+		commands.Clear();
+		commands.SetDrawBlendMode(SDL_BLENDMODE_NONE);
+		ConvertVertices(geometry, translation, inverse ? &outside : &inside, commands.Geometry(nullptr, num_vertices, indices, num_indices));
+		commands.SetDrawBlendMode(blend_mode);
+	}
+	break;
+	case Rml::ClipMaskOperation::Intersect:
+	{
+		SDL_Texture* coverage = AcquireLayerTarget();
+		if (!coverage)
+			break;
+
+		SetTarget(commands, coverage, true);
+		commands.SetDrawColor(0, 0, 0, 0);
+		commands.Clear();
+		ConvertVertices(geometry, translation, &inside, commands.Geometry(nullptr, num_vertices, indices, num_indices));
+		Blit(commands, coverage, clip_mask, mask_blend_mode);
+		target_pool.Release(coverage);
+	}
+	break;
+	}
+
+	SetTarget(commands, layers.back(), true);
+	FlushImmediate();
+}
+
+void RenderInterface_SDL::SetTransform(const Rml::Matrix4f* new_transform)
+{
+	transform_enabled = (new_transform != nullptr);
+	if (new_transform)
+		transform = *new_transform;
+
+	if (ui_capture)
+	{
+		HashUi(&transform_enabled, sizeof(transform_enabled));
+		if (transform_enabled)
+			HashUi(transform.data(), sizeof(float) * 16);
+	}
+}
+
+Rml::LayerHandle RenderInterface_SDL::PushLayer()
+{
+	if (ui_capture)
+		HashUi("push", 4);
+
+	// Without a target the layer aliases the current one: its content is drawn unfiltered rather than lost.
+	SDL_Texture* target = AcquireLayerTarget();
+	if (!target)
+	{
+		layers.push_back(layers.back());
+		return (Rml::LayerHandle)(layers.size() - 1);
+	}
+
+	core::render::CommandBuffer& commands = Recorder();
+	SetTarget(commands, target, true);
+	commands.SetDrawColor(0, 0, 0, 0);
+	commands.Clear();
+	FlushImmediate();
+
+	layers.push_back(target);
+	return (Rml::LayerHandle)(layers.size() - 1);
+}
+
+void RenderInterface_SDL::CompositeLayers(Rml::LayerHandle source, Rml::LayerHandle destination, Rml::BlendMode mode,
+	Rml::Span<const Rml::CompiledFilterHandle> filters)
+{
+	RMLUI_ASSERT(source < layers.size() && destination < layers.size());
+
+	if (ui_capture)
+	{
+		HashUi("composite", 9);
+		HashUi(&source, sizeof(source));
+		HashUi(&destination, sizeof(destination));
+		HashUi(&mode, sizeof(mode));
+		for (Rml::CompiledFilterHandle handle : filters)
+			HashUi(&reinterpret_cast<const Filter*>(handle)->id, sizeof(Uint64));
+	}
+
+	// The window can't be sampled, and an aliased layer is already where it belongs.
+	SDL_Texture* source_texture = layers[source];
+	SDL_Texture* destination_texture = layers[destination];
+	if (!source_texture || (source_texture == destination_texture && filters.empty()))
+		return;
+
+	core::render::CommandBuffer& commands = Recorder();
+
+	// Filters work on a copy, the source layer stays untouched.
+	SDL_Texture* working = source_texture;
+	auto Replace = [&](SDL_Texture* texture) {
+		if (working != source_texture)
+			target_pool.Release(working);
+		working = texture;
 	};
-	auto DestroySurface = [](SDL_Surface* surface) { SDL_DestroySurface(surface); };
-#else
-	auto CreateSurface = [&]() {
-		return SDL_CreateRGBSurfaceWithFormatFrom((void*)source.data(), source_dimensions.x, source_dimensions.y, 32, source_dimensions.x * 4,
-			SDL_PIXELFORMAT_RGBA32);
+	auto Modulate = [&](Uint8 color, Uint8 alpha) -> bool {
+		SDL_Texture* copy = AcquireLayerTarget();
+		if (!copy)
+			return false;
+		SetTarget(commands, copy, false);
+		commands.SetTextureBlendMode(working, SDL_BLENDMODE_NONE);
+		commands.SetTextureMod(working, color, color, color, alpha);
+		commands.Texture(working, nullptr, nullptr);
+		commands.SetTextureMod(working, 255, 255, 255, 255);
+		Replace(copy);
+		return true;
 	};
-	auto DestroySurface = [](SDL_Surface* surface) { SDL_FreeSurface(surface); };
-#endif
+	auto ToByte = [](float value) { return (Uint8)(Rml::Math::Clamp(value, 0.f, 1.f) * 255.f + 0.5f); };
 
-	SDL_Surface* surface = CreateSurface();
+	for (Rml::CompiledFilterHandle handle : filters)
+	{
+		const Filter& filter = *reinterpret_cast<const Filter*>(handle);
+		switch (filter.type)
+		{
+		case FilterType::Opacity:
+		{
+			// Premultiplied: color and alpha scale together.
+			const Uint8 opacity = ToByte(filter.value);
+			Modulate(opacity, opacity);
+		}
+		break;
+		case FilterType::Brightness: Modulate(ToByte(filter.value), 255); break;
+		case FilterType::Blur:
+			if (working != source_texture || Modulate(255, 255))
+				Blur(commands, working, filter.sigma);
+			break;
+		case FilterType::DropShadow:
+		{
+			SDL_Texture* shadow = AcquireLayerTarget();
+			SDL_Texture* result = shadow ? AcquireLayerTarget() : nullptr;
+			if (!result)
+			{
+				if (shadow)
+					target_pool.Release(shadow);
+				break;
+			}
 
-	SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+			Blit(commands, working, shadow, SDL_BLENDMODE_NONE);
+			commands.SetDrawBlendMode(shadow_blend_mode);
+			commands.SetDrawColor(filter.color.red, filter.color.green, filter.color.blue, filter.color.alpha);
+			commands.FillRect(nullptr);
+			commands.SetDrawBlendMode(blend_mode);
+			Blur(commands, shadow, filter.sigma);
+
+			const SDL_FRect offset_rect = {filter.offset.x, filter.offset.y, (float)layer_width, (float)layer_height};
+			SetTarget(commands, result, false);
+			commands.SetDrawColor(0, 0, 0, 0);
+			commands.Clear();
+			commands.SetTextureBlendMode(shadow, blend_mode);
+			commands.Texture(shadow, nullptr, &offset_rect);
+			commands.SetTextureBlendMode(working, blend_mode);
+			commands.Texture(working, nullptr, nullptr);
+			target_pool.Release(shadow);
+			Replace(result);
+		}
+		break;
+		case FilterType::MaskImage:
+			if (working != source_texture || Modulate(255, 255))
+				Blit(commands, filter.mask, working, mask_blend_mode);
+			break;
+		}
+	}
+
+	if (working == destination_texture && !Modulate(255, 255))
+		return;
+
+	SetTarget(commands, destination_texture, true);
+	commands.SetTextureBlendMode(working, mode == Rml::BlendMode::Replace ? SDL_BLENDMODE_NONE : blend_mode);
+	commands.SetTextureMod(working, 255, 255, 255, 255);
+	commands.Texture(working, nullptr, nullptr);
+	Replace(source_texture);
+
+	SetTarget(commands, layers.back(), true);
+	FlushImmediate();
+}
+
+void RenderInterface_SDL::PopLayer()
+{
+	if (layers.size() <= 1)
+		return;
+
+	if (ui_capture)
+		HashUi("pop", 3);
+
+	SDL_Texture* target = layers.back();
+	layers.pop_back();
+	if (target != layers.back())
+		target_pool.Release(target);
+
+	SetTarget(Recorder(), layers.back(), true);
+	FlushImmediate();
+}
+
+Rml::TextureHandle RenderInterface_SDL::SaveLayerAsTexture()
+{
+	SDL_Texture* layer = layers.back();
+	if (!layer)
+	{
+		Rml::Log::Message(Rml::Log::LT_WARNING, "Can't save the base layer as a texture, push a layer first.");
+		return {};
+	}
+
+	// The texture covers the scissor region, which RmlUi sets to the area it wants to keep.
+	SDL_Rect region = scissor_region_enabled ? rect_scissor : SDL_Rect{0, 0, layer_width, layer_height};
+	if (region.w <= 0 || region.h <= 0)
+		return {};
+
+	SDL_Texture* texture = nullptr;
+	{
+		core::render::RenderLock lock(render_queue);
+		texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, region.w, region.h);
+	}
+	if (!texture)
+	{
+		SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Couldn't create a %dx%d texture for a saved layer: %s", region.w, region.h, SDL_GetError());
+		return {};
+	}
 	SDL_SetTextureBlendMode(texture, blend_mode);
+	texture_generation++;
 
-	DestroySurface(surface);
-	return (Rml::TextureHandle)texture;
+	const SDL_FRect source_rect = {(float)region.x, (float)region.y, (float)region.w, (float)region.h};
+	core::render::CommandBuffer& commands = Recorder();
+	SetTarget(commands, texture, false);
+	commands.SetTextureBlendMode(layer, SDL_BLENDMODE_NONE);
+	commands.SetTextureMod(layer, 255, 255, 255, 255);
+	commands.Texture(layer, &source_rect, nullptr);
+	commands.SetTextureBlendMode(layer, blend_mode);
+	SetTarget(commands, layer, true);
+	FlushImmediate();
+
+	return AddTexture(texture, {});
 }
 
-void RenderInterface_SDL::ReleaseTexture(Rml::TextureHandle texture_handle)
+Rml::CompiledFilterHandle RenderInterface_SDL::SaveLayerAsMaskImage()
+{
+	SDL_Texture* layer = layers.back();
+	SDL_Texture* mask = layer ? AcquireLayerTarget() : nullptr;
+	if (!mask)
+		return {};
+
+	core::render::CommandBuffer& commands = Recorder();
+	Blit(commands, layer, mask, SDL_BLENDMODE_NONE);
+	SetTarget(commands, layer, true);
+	FlushImmediate();
+
+	Filter* filter = new Filter{FilterType::MaskImage};
+	filter->mask = mask;
+	filter->id = next_filter_id++;
+	return reinterpret_cast<Rml::CompiledFilterHandle>(filter);
+}
+
+template <typename T>
+static T GetParameter(const Rml::Dictionary& parameters, const Rml::String& name, T default_value)
+{
+	auto it = parameters.find(name);
+	return it != parameters.end() ? it->second.Get<T>(default_value) : default_value;
+}
+
+Rml::CompiledFilterHandle RenderInterface_SDL::CompileFilter(const Rml::String& name, const Rml::Dictionary& parameters)
+{
+	Filter filter = {};
+	if (name == "opacity")
+	{
+		filter.type = FilterType::Opacity;
+		filter.value = GetParameter(parameters, "value", 1.f);
+	}
+	else if (name == "brightness")
+	{
+		// Color modulation can only darken.
+		filter.type = FilterType::Brightness;
+		filter.value = GetParameter(parameters, "value", 1.f);
+	}
+	else if (name == "blur")
+	{
+		filter.type = FilterType::Blur;
+		filter.sigma = GetParameter(parameters, "sigma", 0.f);
+	}
+	else if (name == "drop-shadow")
+	{
+		filter.type = FilterType::DropShadow;
+		filter.sigma = GetParameter(parameters, "sigma", 0.f);
+		filter.color = GetParameter(parameters, "color", Rml::Colourb()).ToPremultiplied();
+		filter.offset = GetParameter(parameters, "offset", Rml::Vector2f(0.f, 0.f));
+	}
+	else
+	{
+		Rml::Log::Message(Rml::Log::LT_WARNING, "Unsupported filter type '%s'.", name.c_str());
+		return {};
+	}
+
+	filter.id = next_filter_id++;
+	return reinterpret_cast<Rml::CompiledFilterHandle>(new Filter(filter));
+}
+
+void RenderInterface_SDL::ReleaseFilter(Rml::CompiledFilterHandle handle)
 {
-	SDL_DestroyTexture((SDL_Texture*)texture_handle);
+	Filter* filter = reinterpret_cast<Filter*>(handle);
+	if (filter->mask)
+		target_pool.Release(filter->mask);
+	delete filter;
 }
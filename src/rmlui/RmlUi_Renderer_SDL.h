@@ -30,6 +30,10 @@
 #define RMLUI_BACKENDS_RENDERER_SDL_H
 
 #include <RmlUi/Core/RenderInterface.h>
+#include "core/memory/FrameArena.h"
+#include "core/render/RenderQueue.h"
+#include "core/render/RenderTargetPool.h"
+#include "core/render/TextureManager.h"
 
 #if RMLUI_SDL_VERSION_MAJOR == 3
 	#include <SDL3/SDL.h>
@@ -42,11 +46,63 @@
 class RenderInterface_SDL : public Rml::RenderInterface {
 public:
 	RenderInterface_SDL(SDL_Renderer* renderer);
+	~RenderInterface_SDL();
 
 	// Sets up OpenGL states for taking rendering commands from RmlUi.
 	void BeginFrame();
 	void EndFrame();
 
+	// Per-frame vertex scratch is taken from this arena when set; it must be reset after the frame is presented.
+	void SetFrameArena(core::memory::FrameArena* arena) { frame_arena = arena; }
+
+	// When set, rendering is recorded into the queue instead of issued on the renderer.
+	void SetRenderQueue(core::render::RenderQueue* queue);
+
+	// When set, UI textures are owned by the manager under the "ui" owner and texture handles are its ids.
+	// Textures loaded from files may then be evicted and are reloaded on their next draw.
+	void SetTextureManager(core::render::TextureManager* manager) { texture_manager = manager; }
+
+	// Renders the context through the UI cache: with a render queue set, output that is identical to the previous
+	// frame is drawn from a target texture as a single quad instead of re-issuing all of its geometry.
+	void RenderContext(Rml::Context* context);
+	void SetUiCacheEnabled(bool enable) { ui_cache_enabled = enable; }
+
+	struct UiCacheStats {
+		Uint64 hits = 0;     // Frames drawn from the cached texture.
+		Uint64 rebuilds = 0; // Frames that re-rendered the cached texture.
+		Uint64 bypassed = 0; // Frames drawn directly because the output kept changing.
+	};
+	const UiCacheStats& GetUiCacheStats() const { return ui_cache_stats; }
+
+	struct CullStats {
+		Uint64 draws = 0;           // Geometry submitted by RmlUi this frame.
+		Uint64 culled_draws = 0;    // Skipped because it lies outside the scissor region or the target.
+		Uint64 culled_vertices = 0;
+	};
+	const CullStats& GetCullStats() const { return cull_stats; }
+
+	// Axis-aligned quads with a uniform color (backgrounds, borders, glyphs) are drawn as filled or textured
+	// rectangles instead of triangles, which is much cheaper on the software renderer.
+	void SetQuadFastPathEnabled(bool enable) { quad_fast_path_enabled = enable; }
+
+	struct GeometryPathStats {
+		Uint64 solid_rects = 0;    // Untextured quads drawn with a rect fill this frame.
+		Uint64 textured_quads = 0; // Textured quads drawn as a texture copy this frame.
+		Uint64 meshes = 0;         // Everything else, drawn as triangles.
+	};
+	const GeometryPathStats& GetGeometryPathStats() const { return path_stats; }
+
+	struct GeneratedTextureStats {
+		Uint64 created = 0;  // Streaming textures created for GenerateTexture.
+		Uint64 reused = 0;   // Generated textures served by a released texture of the same size.
+		Uint64 uploaded = 0; // Bytes sent with SDL_UpdateTexture.
+	};
+	const GeneratedTextureStats& GetGeneratedTextureStats() const { return generated_stats; }
+
+	// Targets used by layers, filters and clip masks.
+	const core::render::RenderTargetPool::Stats& GetRenderTargetStats() const { return target_pool.GetStats(); }
+	float GetRenderTargetHitRate() const { return target_pool.GetHitRate(); }
+
 	// -- Inherited from Rml::RenderInterface --
 
 	Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices) override;
@@ -60,16 +116,126 @@ public:
 	void EnableScissorRegion(bool enable) override;
 	void SetScissorRegion(Rml::Rectanglei region) override;
 
+	void EnableClipMask(bool enable) override;
+	void RenderToClipMask(Rml::ClipMaskOperation operation, Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation) override;
+
+	void SetTransform(const Rml::Matrix4f* transform) override;
+
+	Rml::LayerHandle PushLayer() override;
+	void CompositeLayers(Rml::LayerHandle source, Rml::LayerHandle destination, Rml::BlendMode blend_mode,
+		Rml::Span<const Rml::CompiledFilterHandle> filters) override;
+	void PopLayer() override;
+
+	Rml::TextureHandle SaveLayerAsTexture() override;
+	Rml::CompiledFilterHandle SaveLayerAsMaskImage() override;
+
+	Rml::CompiledFilterHandle CompileFilter(const Rml::String& name, const Rml::Dictionary& parameters) override;
+	void ReleaseFilter(Rml::CompiledFilterHandle filter) override;
+
 private:
 	struct GeometryView {
 		Rml::Span<const Rml::Vertex> vertices;
 		Rml::Span<const int> indices;
+		Uint64 id; // Unique per compiled geometry, unlike the handle which may be reused after release.
+		Rml::Vector2f min, max; // Untranslated bounding box, for culling.
+
+		// Set when the geometry is exactly the box above, two triangles with a single color.
+		bool is_quad;
+		Rml::ColourbPremultiplied quad_colour;
+		Rml::Vector2f uv_min, uv_max;
 	};
 
+	// Filters that can be expressed with texture modulation, blending and rescaling. The rest need shaders.
+	enum class FilterType { Opacity, Brightness, Blur, DropShadow, MaskImage };
+	struct Filter {
+		FilterType type;
+		float value = 1.f;               // Opacity, brightness
+		float sigma = 0.f;               // Blur, drop shadow
+		Rml::ColourbPremultiplied color; // Drop shadow
+		Rml::Vector2f offset;            // Drop shadow
+		SDL_Texture* mask = nullptr;     // Mask image, owned by the target pool
+		Uint64 id;
+	};
+
+	SDL_Texture* GetTexture(Rml::TextureHandle texture_handle);
+	Rml::TextureHandle AddTexture(SDL_Texture* texture, core::render::TextureManager::Loader reload);
+	void DestroyTexture(Rml::TextureHandle texture_handle);
+	SDL_Texture* CreateTextureFromFile(const Rml::String& source, Rml::Vector2i& texture_dimensions);
+
+	void UploadGeneratedTexture(SDL_Texture* texture, Rml::Span<const Rml::byte> source, int width, const Rml::byte* previous, int height);
+	void TrimGeneratedTextures(int max_idle_frames);
+
+	core::render::CommandBuffer* Commands();
+	core::render::CommandBuffer& Recorder();
+	void FlushImmediate();
+	void HashUi(const void* data, size_t size);
+	bool EnsureUiCache(int width, int height);
+
+	void ConvertVertices(const GeometryView* geometry, Rml::Vector2f translation, const SDL_FColor* forced_color, SDL_Vertex* out) const;
+	void SetTarget(core::render::CommandBuffer& commands, SDL_Texture* target, bool clip);
+	void Blit(core::render::CommandBuffer& commands, SDL_Texture* source, SDL_Texture* destination, SDL_BlendMode mode);
+	void Blur(core::render::CommandBuffer& commands, SDL_Texture* texture, float sigma);
+	bool IsCulled(const GeometryView* geometry, Rml::Vector2f translation);
+	void DrawQuad(core::render::CommandBuffer* commands, const GeometryView* geometry, Rml::Vector2f translation, SDL_Texture* texture);
+	void UpdateLayerSize();
+	SDL_Texture* AcquireLayerTarget();
+	void EndLayers();
+
 	SDL_Renderer* renderer;
+	core::memory::FrameArena* frame_arena = nullptr;
+	core::render::RenderQueue* render_queue = nullptr;
+	core::render::TextureManager* texture_manager = nullptr;
+	Rml::Vector<SDL_Vertex> vertex_scratch;
 	SDL_BlendMode blend_mode = {};
 	SDL_Rect rect_scissor = {};
 	bool scissor_region_enabled = false;
+
+	Uint64 next_geometry_id = 1;
+	Uint64 next_filter_id = 1;
+	Uint64 texture_generation = 0; // Bumped whenever a texture is created or released.
+	Uint64 frame_index = 1;
+
+	// Generated textures (font atlases, mostly) are streaming textures with a CPU copy of their pixels. RmlUi regenerates
+	// an atlas by releasing it and generating a new one; the released texture is kept and patched instead, uploading
+	// only the region that differs.
+	struct GeneratedTexture {
+		Rml::TextureHandle handle;
+		int width, height;
+		SDL_PixelFormat format; // RGBA32, or compact for alpha-only content; reuse needs the same.
+		Rml::Vector<Rml::byte> pixels;
+		Uint64 released_frame; // 0 while RmlUi uses it.
+	};
+	Rml::Vector<GeneratedTexture> generated_textures;
+	GeneratedTextureStats generated_stats;
+	CullStats cull_stats;
+	bool quad_fast_path_enabled = true;
+	GeometryPathStats path_stats;
+
+	// UI cache
+	bool ui_cache_enabled = true;
+	bool ui_capture = false; // Recording Context::Render into ui_commands.
+	core::render::CommandBuffer ui_commands;
+	Rml::Vector<Rml::TextureHandle> ui_deferred_releases;
+	SDL_Texture* ui_cache = nullptr;
+	int ui_cache_width = 0;
+	int ui_cache_height = 0;
+	Uint64 ui_hash = 0;
+	Uint64 ui_cached_hash = 0;
+	Uint64 ui_last_hash = 0;
+	UiCacheStats ui_cache_stats;
+
+	// Layers, filters and masks
+	core::render::RenderTargetPool target_pool;
+	core::render::CommandBuffer immediate_commands; // Offscreen work when there is no render queue.
+	Rml::Vector<SDL_Texture*> layers;               // layers[0] is the base target.
+	int layer_width = 0;
+	int layer_height = 0;
+	SDL_BlendMode mask_blend_mode = {};   // dst *= src alpha
+	SDL_BlendMode shadow_blend_mode = {}; // dst = src color * dst alpha
+	SDL_Texture* clip_mask = nullptr;
+	bool clip_mask_enabled = false;
+	bool transform_enabled = false;
+	Rml::Matrix4f transform;
 };
 
 #endif
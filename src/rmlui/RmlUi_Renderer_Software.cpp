@@ -0,0 +1,261 @@
+#include "RmlUi_Renderer_Software.h"
+#include "core/assets/AssetPack.h"
+#include "core/assets/CookedTexture.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/Types.h>
+#include <SDL3_image/SDL_image.h>
+#include <string.h>
+
+RenderInterface_Software::RenderInterface_Software(SDL_Renderer* renderer) : renderer(renderer) {}
+
+RenderInterface_Software::~RenderInterface_Software()
+{
+	for (Texture* texture : deferred_releases)
+		delete texture;
+
+	for (SDL_Texture* texture : output)
+	{
+		if (!texture)
+			continue;
+		if (render_queue)
+			render_queue->DestroyTexture(texture);
+		else
+			SDL_DestroyTexture(texture);
+	}
+}
+
+bool RenderInterface_Software::EnsureOutput(int width, int height)
+{
+	if (output[0] && output_width == width && output_height == height)
+		return true;
+
+	for (SDL_Texture*& texture : output)
+	{
+		if (texture)
+		{
+			if (render_queue)
+				render_queue->DestroyTexture(texture);
+			else
+				SDL_DestroyTexture(texture);
+			texture = nullptr;
+		}
+	}
+
+	core::render::RenderLock lock(render_queue);
+	for (SDL_Texture*& texture : output)
+	{
+		texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, width, height);
+		if (!texture)
+		{
+			SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Couldn't create a %dx%d UI output texture: %s", width, height, SDL_GetError());
+			return false;
+		}
+		// The framebuffer holds premultiplied colors, like everything RmlUi renders. A predefined mode, since
+		// SDL's software renderer, the one this backend is picked for, rejects custom blend modes.
+		if (!SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED))
+		{
+			SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Couldn't set the blend mode of the UI output texture: %s", SDL_GetError());
+			return false;
+		}
+	}
+	output_width = width;
+	output_height = height;
+	return true;
+}
+
+void RenderInterface_Software::RenderContext(Rml::Context* context)
+{
+	int width = 0, height = 0;
+	if (render_queue)
+		render_queue->GetOutputSize(&width, &height);
+	else
+		SDL_GetCurrentRenderOutputSize(renderer, &width, &height);
+	if (width <= 0 || height <= 0 || !EnsureOutput(width, height))
+		return;
+
+	rasterizer.Begin(width, height);
+	scissor_region_enabled = false;
+	rendering = true;
+	context->Render();
+	rasterizer.Finish();
+	rendering = false;
+
+	for (Texture* texture : deferred_releases)
+		delete texture;
+	deferred_releases.clear();
+
+	// One upload for the whole UI. SDL_UpdateTexture copies the pixels, so the framebuffer is free again afterwards.
+	SDL_Texture* texture = output[output_index];
+	output_index = (output_index + 1) % 2;
+	{
+		core::render::RenderLock lock(render_queue);
+		SDL_UpdateTexture(texture, nullptr, rasterizer.GetPixels(), width * (int)sizeof(core::render::SoftwareRasterizer::Pixel));
+	}
+
+	if (render_queue)
+	{
+		core::render::CommandBuffer& commands = render_queue->Recording();
+		commands.SetClipRect(nullptr);
+		commands.Texture(texture, nullptr, nullptr);
+	}
+	else
+	{
+		SDL_SetRenderClipRect(renderer, nullptr);
+		SDL_RenderTexture(renderer, texture, nullptr, nullptr);
+	}
+}
+
+Rml::CompiledGeometryHandle RenderInterface_Software::CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices)
+{
+	GeometryView* data = new GeometryView{vertices, indices};
+	return reinterpret_cast<Rml::CompiledGeometryHandle>(data);
+}
+
+void RenderInterface_Software::ReleaseGeometry(Rml::CompiledGeometryHandle geometry)
+{
+	delete reinterpret_cast<GeometryView*>(geometry);
+}
+
+void RenderInterface_Software::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture)
+{
+	const GeometryView* geometry = reinterpret_cast<GeometryView*>(handle);
+	const Rml::Vertex* vertices = geometry->vertices.data();
+	const size_t num_vertices = geometry->vertices.size();
+
+	core::render::SoftwareRasterizer::Vertex* converted = nullptr;
+	if (frame_arena)
+	{
+		converted = frame_arena->AllocateArray<core::render::SoftwareRasterizer::Vertex>(num_vertices);
+	}
+	else
+	{
+		if (vertex_scratch.size() < num_vertices)
+			vertex_scratch.resize(num_vertices);
+		converted = vertex_scratch.data();
+	}
+
+	for (size_t i = 0; i < num_vertices; i++)
+	{
+		Rml::Vector2f position = vertices[i].position + translation;
+		if (transform_enabled)
+		{
+			const Rml::Vector4f projected = transform * Rml::Vector4f(position.x, position.y, 0.f, 1.f);
+			const float w = (projected.w != 0.f ? projected.w : 1.f);
+			position = {projected.x / w, projected.y / w};
+		}
+
+		core::render::SoftwareRasterizer::Vertex& out = converted[i];
+		out.x = position.x;
+		out.y = position.y;
+		out.u = vertices[i].tex_coord.x;
+		out.v = vertices[i].tex_coord.y;
+		// Same byte order as the framebuffer: red, green, blue, alpha.
+		memcpy(&out.color, &vertices[i].colour, sizeof(out.color));
+	}
+
+	rasterizer.DrawTriangles(converted, (int)num_vertices, geometry->indices.data(), (int)geometry->indices.size(),
+		reinterpret_cast<const Texture*>(texture));
+}
+
+void RenderInterface_Software::EnableScissorRegion(bool enable)
+{
+	rasterizer.SetScissor(enable ? &rect_scissor : nullptr);
+	scissor_region_enabled = enable;
+}
+
+void RenderInterface_Software::SetScissorRegion(Rml::Rectanglei region)
+{
+	rect_scissor.x = region.Left();
+	rect_scissor.y = region.Top();
+	rect_scissor.w = region.Width();
+	rect_scissor.h = region.Height();
+
+	if (scissor_region_enabled)
+		rasterizer.SetScissor(&rect_scissor);
+}
+
+void RenderInterface_Software::SetTransform(const Rml::Matrix4f* new_transform)
+{
+	transform_enabled = (new_transform != nullptr);
+	if (new_transform)
+		transform = *new_transform;
+}
+
+Rml::TextureHandle RenderInterface_Software::LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source)
+{
+	// A cooked RGBA32 image is the texture layout already, only the rows need copying.
+	core::assets::CookedTexture cooked;
+	if (cooked.Open(source) && cooked.GetFormat() == SDL_PIXELFORMAT_RGBA32)
+	{
+		Texture* texture = new Texture{cooked.GetWidth(), cooked.GetHeight(), {}};
+		texture->pixels.resize((size_t)texture->width * texture->height);
+		const size_t row_size = (size_t)texture->width * 4;
+		for (int y = 0; y < texture->height; y++)
+			memcpy(texture->pixels.data() + (size_t)y * texture->width, cooked.GetPixels() + (size_t)y * cooked.GetPitch(), row_size);
+
+		texture_dimensions = {texture->width, texture->height};
+		return reinterpret_cast<Rml::TextureHandle>(texture);
+	}
+
+	SDL_IOStream* io = core::assets::OpenAsset(source);
+	if (!io)
+		return {};
+
+	const size_t i_ext = source.rfind('.');
+	Rml::String extension = (i_ext == Rml::String::npos ? Rml::String() : source.substr(i_ext + 1));
+
+	SDL_Surface* surface = IMG_LoadTyped_IO(io, true, extension.c_str());
+	if (!surface)
+		return {};
+
+	if (surface->format != SDL_PIXELFORMAT_RGBA32)
+	{
+		SDL_Surface* converted_surface = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+		SDL_DestroySurface(surface);
+		if (!converted_surface)
+			return {};
+		surface = converted_surface;
+	}
+
+	// Convert colors to premultiplied alpha while copying the rows out of the surface.
+	Texture* texture = new Texture{surface->w, surface->h, {}};
+	texture->pixels.resize((size_t)surface->w * surface->h);
+	Rml::byte* destination = reinterpret_cast<Rml::byte*>(texture->pixels.data());
+	for (int y = 0; y < surface->h; y++)
+	{
+		const Rml::byte* row = static_cast<const Rml::byte*>(surface->pixels) + (size_t)y * surface->pitch;
+		for (int x = 0; x < surface->w * 4; x += 4, destination += 4)
+		{
+			const Rml::byte alpha = row[x + 3];
+			for (int j = 0; j < 3; ++j)
+				destination[j] = Rml::byte(int(row[x + j]) * int(alpha) / 255);
+			destination[3] = alpha;
+		}
+	}
+
+	texture_dimensions = {surface->w, surface->h};
+	SDL_DestroySurface(surface);
+	return reinterpret_cast<Rml::TextureHandle>(texture);
+}
+
+Rml::TextureHandle RenderInterface_Software::GenerateTexture(Rml::Span<const Rml::byte> source, Rml::Vector2i source_dimensions)
+{
+	RMLUI_ASSERT(source.data() && source.size() == size_t(source_dimensions.x * source_dimensions.y * 4));
+
+	// Generated textures are already premultiplied.
+	Texture* texture = new Texture{source_dimensions.x, source_dimensions.y, {}};
+	texture->pixels.resize((size_t)source_dimensions.x * source_dimensions.y);
+	memcpy(texture->pixels.data(), source.data(), source.size());
+	return reinterpret_cast<Rml::TextureHandle>(texture);
+}
+
+void RenderInterface_Software::ReleaseTexture(Rml::TextureHandle texture_handle)
+{
+	// Triangles recorded this frame may still sample the texture.
+	Texture* texture = reinterpret_cast<Texture*>(texture_handle);
+	if (rendering)
+		deferred_releases.push_back(texture);
+	else
+		delete texture;
+}
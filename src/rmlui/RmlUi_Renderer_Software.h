@@ -0,0 +1,78 @@
+#ifndef RMLUI_BACKENDS_RENDERER_SOFTWARE_H
+#define RMLUI_BACKENDS_RENDERER_SOFTWARE_H
+
+#include <RmlUi/Core/RenderInterface.h>
+#include <SDL3/SDL.h>
+#include "core/memory/FrameArena.h"
+#include "core/render/RenderQueue.h"
+#include "core/render/SoftwareRasterizer.h"
+
+// RmlUi renderer for machines without a GPU. The UI is rasterized on the CPU by core::render::SoftwareRasterizer
+// and uploaded once per frame into a streaming texture, which is drawn over the frame as a single quad. With SDL's
+// software renderer this replaces thousands of small SDL_RenderGeometry calls by one copy.
+class RenderInterface_Software : public Rml::RenderInterface {
+public:
+	RenderInterface_Software(SDL_Renderer* renderer);
+	~RenderInterface_Software();
+
+	// When set, the upload is recorded into the queue instead of issued on the renderer.
+	void SetRenderQueue(core::render::RenderQueue* queue) { render_queue = queue; }
+
+	// Per-draw vertex scratch is taken from this arena when set; the rasterizer copies the vertices before returning.
+	void SetFrameArena(core::memory::FrameArena* arena) { frame_arena = arena; }
+
+	// Rasterizes the tiles on the scheduler's threads instead of only the calling one.
+	void SetScheduler(core::jobs::Scheduler* scheduler) { rasterizer.SetScheduler(scheduler); }
+
+	// Rasterizes the context and draws the result over the current frame.
+	void RenderContext(Rml::Context* context);
+
+	const core::render::SoftwareRasterizer::Stats& GetRasterizerStats() const { return rasterizer.GetStats(); }
+
+	// -- Inherited from Rml::RenderInterface --
+
+	Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices) override;
+	void ReleaseGeometry(Rml::CompiledGeometryHandle geometry) override;
+	void RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture) override;
+
+	Rml::TextureHandle LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+	Rml::TextureHandle GenerateTexture(Rml::Span<const Rml::byte> source, Rml::Vector2i source_dimensions) override;
+	void ReleaseTexture(Rml::TextureHandle texture_handle) override;
+
+	void EnableScissorRegion(bool enable) override;
+	void SetScissorRegion(Rml::Rectanglei region) override;
+
+	void SetTransform(const Rml::Matrix4f* transform) override;
+
+private:
+	using Texture = core::render::SoftwareRasterizer::Texture;
+
+	struct GeometryView {
+		Rml::Span<const Rml::Vertex> vertices;
+		Rml::Span<const int> indices;
+	};
+
+	bool EnsureOutput(int width, int height);
+
+	SDL_Renderer* renderer;
+	core::render::RenderQueue* render_queue = nullptr;
+	core::memory::FrameArena* frame_arena = nullptr;
+	core::render::SoftwareRasterizer rasterizer;
+	Rml::Vector<core::render::SoftwareRasterizer::Vertex> vertex_scratch;
+	SDL_Rect rect_scissor = {};
+	bool scissor_region_enabled = false;
+	bool transform_enabled = false;
+	Rml::Matrix4f transform;
+
+	// Two streaming textures, alternated so the upload never overwrites a frame the render thread still draws.
+	SDL_Texture* output[2] = {};
+	int output_index = 0;
+	int output_width = 0;
+	int output_height = 0;
+
+	// Released while rasterizing: deleted once the frame is finished.
+	bool rendering = false;
+	Rml::Vector<Texture*> deferred_releases;
+};
+
+#endif
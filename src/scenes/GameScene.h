@@ -1,12 +1,13 @@
 #ifndef SCENES_GAME_SCENE_H
 #define SCENES_GAME_SCENE_H
 
-#include <SDL3_mixer/SDL_mixer.h>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "core/scene/Scene.h"
 #include "game/Mode.h"
-#include "game/Components.h"
+#include "game/sim/Match.h"
 #include <RmlUi/Core/ElementDocument.h>
 
 
@@ -29,61 +30,37 @@ public:
     void Update(float deltaTime) override;
     void Render() override;
 
-    void onSecondCounterTimer();
-
 private:
     // Game constants
     game::mode::Mode gameMode;
 
-    int initialSpeed = 360;
-
-    // Game variables
-    int scores[2]{0, 0}; // Scores for player 1 and player 2
-    int gameTime{};
-    int soloScore{};
-    int multiplier{};
-    int winning_points{};
-    SDL_TimerID secondCounterTimer;
+    // Ball, paddles and score; the scene only feeds it input and shows it
+    game::sim::Match match;
     float timeAfterGameEnded{-1.0f};
 
     // RmlUi
     Rml::ElementDocument* doc{nullptr};
+    std::string scoreText; // Text currently shown in the score label
 
-    // Components
-    struct Ball {
-        Radius radius;
-        Velocity velocity;
-        Speed speed;
-        SDL_Texture* sprite{nullptr};
-        SDL_FRect rec;
-    } ball;
-
-    struct Paddle {
-        SDL_FRect rec;
-        Speed speed;
-        int direction{}; // 0, 1 or -1
-    };
-    
-    SDL_Texture* paddleSprite{nullptr};
-    Paddle paddles[2]; // Paddles for players
-    Size2D lastKnownRenderSize; // To compare on resize
+    // Sprites
+    core::render::TextureId ballSprite{core::render::INVALID_TEXTURE};
+    core::render::TextureId paddleSprite{core::render::INVALID_TEXTURE};
 
     // SDL resources
     SDL_Texture *scoreTexture{nullptr};
-    Mix_Chunk *wallBounceSound{nullptr};
-    Mix_Chunk *paddleBounceSound{nullptr};
-    Mix_Chunk *scoreSound{nullptr};
+    core::audio::SoundId wallBounceSound{core::audio::INVALID_SOUND};
+    core::audio::SoundId paddleBounceSound{core::audio::INVALID_SOUND};
+    core::audio::SoundId scoreSound{core::audio::INVALID_SOUND};
 
     // Helper functions
-    void ResetBall();
-    void UpdatePaddleMovement(int paddleIndex, int direction, float deltaTime);
-    void CheckCollisions();
+    void ReadInput();
+    void PlaySounds(uint32_t events);
     bool LoadSound(const std::string &path);
-    SDL_Texture* LoadImageTexture(const std::string &path);
+    core::render::TextureId LoadImageTexture(const std::string &path);
     void adjustToScreen();
-    void UpdateScore(int scorerIndex);
+    void SetScoreText(std::string_view text);
     void UpdateScoreDisplay();
-    void CheckGameOver();
+    void ShowGameOver();
 };
 
 #endif // SCENES_GAME_SCENE_H
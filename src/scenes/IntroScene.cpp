@@ -1,11 +1,10 @@
-#include <SDL3_image/SDL_image.h>
 #include <filesystem>
 #include <cmath>
 
 #include "IntroScene.h"
 
 IntroScene::IntroScene(AppContext *context)
-    : Scene("Intro", context) {}
+    : Scene("Intro", context), sprites(context->textures, context->svgs) {}
 
 IntroScene::~IntroScene()
 {
@@ -34,9 +33,9 @@ void IntroScene::Ready()
 
 void IntroScene::OnEnter()
 {
-    if (music)
+    if (!musicPath.empty())
     {
-        Mix_PlayMusic(music, 0);
+        app->music->Play(musicPath, MUSIC_FADE_SECONDS, false); // The intro track plays once
     }
     else
     {
@@ -46,26 +45,18 @@ void IntroScene::OnEnter()
 
 void IntroScene::OnExit()
 {
-    Mix_HaltMusic();
+    app->music->Stop(MUSIC_FADE_SECONDS);
 }
 
 void IntroScene::CleanUp()
 {
     if (messageTex)
     {
-        SDL_DestroyTexture(messageTex);
+        app->renderQueue->DestroyTexture(messageTex);
         messageTex = nullptr;
     }
-    if (imageTex)
-    {
-        SDL_DestroyTexture(imageTex);
-        imageTex = nullptr;
-    }
-    if (music)
-    {
-        Mix_FreeMusic(music);
-        music = nullptr;
-    }
+    sprites.Clear();
+    imagePath.clear();
 }
 
 SDL_AppResult IntroScene::HandleEvent(SDL_Event *event)
@@ -80,52 +71,34 @@ void IntroScene::Update(float deltaTime)
 
 void IntroScene::Render()
 {
+    core::render::CommandBuffer &commands = app->renderQueue->Recording();
+
     float time = SDL_GetTicks() / 1000.0f;
     Uint8 r = Uint8((std::sin(time) + 1.0f) * 0.5f * 255);
     Uint8 g = Uint8((std::sin(time / 2.0f) + 1.0f) * 0.5f * 255);
     Uint8 b = Uint8((std::sin(time * 2.0f) + 1.0f) * 0.5f * 255);
 
-    SDL_SetRenderDrawColor(app->renderer, r, g, b, SDL_ALPHA_OPAQUE);
-    SDL_RenderClear(app->renderer);
+    commands.SetDrawColor(r, g, b, SDL_ALPHA_OPAQUE);
+    commands.Clear();
 
-    if (imageTex)
-        SDL_RenderTexture(app->renderer, imageTex, nullptr, nullptr);
+    sprites.Render(commands, app->outputWidth, app->outputHeight);
     if (messageTex)
-        SDL_RenderTexture(app->renderer, messageTex, nullptr, &messageDest);
-
-    SDL_RenderPresent(app->renderer);
+        commands.Texture(messageTex, nullptr, &messageDest);
 }
 
 // Utility loaders
 bool IntroScene::LoadImageTexture(const std::string &path)
 {
-    SDL_Surface *surface = IMG_Load(path.c_str());
-    if (!surface)
-    {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load image: %s", SDL_GetError());
+    if (!app->svgs->Load(path))
         return false;
-    }
-
-    imageTex = SDL_CreateTextureFromSurface(app->renderer, surface);
-    SDL_DestroySurface(surface);
-
-    if (!imageTex)
-    {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create image texture: %s", SDL_GetError());
-        return false;
-    }
-
+    imagePath = path;
+    sprites.Add({.svg = path, .scaleMode = core::utils::image::ScaleMode::Stretch});
     return true;
 }
 
 bool IntroScene::LoadMusic(const std::string &path)
 {
-    music = Mix_LoadMUS(path.c_str());
-    if (!music)
-    {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load music: %s", SDL_GetError());
-        return false;
-    }
-    // Mix_PlayMusic(music, 0);
+    // The music player opens and decodes the file on its own thread when it starts playing.
+    musicPath = path;
     return true;
 }
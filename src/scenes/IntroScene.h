@@ -2,8 +2,8 @@
 #define SCENES_INTRO_SCENE_H
 
 #include "core/scene/Scene.h"
+#include "core/scene/SpriteLayer.h"
 #include <SDL3/SDL.h>
-#include <SDL3_mixer/SDL_mixer.h>
 
 class IntroScene : public core::scene::Scene {
 public:
@@ -24,8 +24,9 @@ public:
 
 private:
     SDL_Texture* messageTex{nullptr};
-    SDL_Texture* imageTex{nullptr};
-    Mix_Music* music{nullptr};
+    std::string imagePath; ///< SVG drawn through the shared raster cache.
+    core::scene::SpriteLayer sprites;
+    std::string musicPath;
     SDL_FRect messageDest{};
 
     bool LoadImageTexture(const std::string& path);
@@ -1,4 +1,3 @@
-#include <SDL3_image/SDL_image.h>
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/ElementDocument.h>
 #include <filesystem>
@@ -6,6 +5,7 @@
 
 #include "MainMenuScene.h"
 #include "core/scene/Events.h"
+#include "core/memory/AllocationTracker.h"
 
 class RmlUiEventListener : public Rml::EventListener
 {
@@ -14,18 +14,18 @@ public:
     void ProcessEvent(Rml::Event &event) override
     {
         Rml::Element *target = event.GetCurrentElement();
-        std::string id = target->GetId().c_str();
+        const Rml::String &id = target->GetId();
 
         if (event.GetType() == "focus")
         {
             // Reproduce el sonido al enfocar un botón
-            Mix_PlayChannel(-1, owner->moveSound, 0);
+            owner->PlaySound(owner->moveSound);
             return;
         }
 
         if (event.GetType() == "click")
         {
-            Mix_PlayChannel(-1, owner->enterSound, 0);
+            owner->PlaySound(owner->enterSound);
             if (id == "solo")
             {
                 game::menu::EmitStartGameEvent(game::mode::SOLO);
@@ -49,13 +49,22 @@ private:
 };
 
 MainMenuScene::MainMenuScene(AppContext *context)
-    : Scene("MainMenu", context) {}
+    : Scene("MainMenu", context), sprites(context->textures, context->svgs) {}
 
 MainMenuScene::~MainMenuScene()
 {
     CleanUp();
 }
 
+void MainMenuScene::Prefetch()
+{
+    std::filesystem::path basePath = SDL_GetBasePath();
+    if (!basePath.empty())
+    {
+        app->textures->Prefetch((basePath / "resources/pong_logo.png").string());
+    }
+}
+
 bool MainMenuScene::Init()
 {
     std::filesystem::path basePath = SDL_GetBasePath();
@@ -67,31 +76,30 @@ bool MainMenuScene::Init()
 
     bool ok =
         LoadImageTexture((basePath / "resources/pong_logo.png").string());
-    moveSound = Mix_LoadWAV("resources/sounds/ping.wav");
-    enterSound = Mix_LoadWAV("resources/sounds/pong.wav");
+    moveSound = app->sfx->Load("resources/sounds/ping.wav");
+    enterSound = app->sfx->Load("resources/sounds/pong.wav");
 
-    // LoadMusic((basePath / "resources/sounds/the_entertainer.ogg").string());
+    LoadMusic((basePath / "resources/sounds/the_entertainer.ogg").string());
 
     return ok;
 }
 
 void MainMenuScene::Ready()
 {
-    // Fonts should be loaded before any documents are loaded.
-    if (Rml::LoadFontFace("resources/monogram.ttf"))
-    {
-        SDL_LogDebug(SDL_LOG_PRIORITY_DEBUG, "Loaded font");
-    }
+    // Fonts are loaded once at startup, before any document.
 }
 
 void MainMenuScene::OnEnter()
 {
-    if (music)
+    if (!musicPath.empty())
     {
-        Mix_PlayMusic(music, 0);
+        app->music->Play(musicPath, MUSIC_FADE_SECONDS);
     }
 
-    doc = app->context->LoadDocument("resources/ui/main_menu_screen.rml");
+    {
+        core::memory::tracking::PhaseScope phase{core::memory::tracking::Phase::DOCUMENT_LOAD};
+        doc = app->context->LoadDocument("resources/ui/main_menu_screen.rml");
+    }
     if (!doc)
     {
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Couldn't read RmlUi document");
@@ -129,7 +137,7 @@ void MainMenuScene::OnEnter()
 
 void MainMenuScene::OnExit()
 {
-    Mix_HaltMusic();
+    app->music->Stop(MUSIC_FADE_SECONDS);
     if (doc)
     {
         doc->Close();
@@ -140,29 +148,13 @@ void MainMenuScene::CleanUp()
 {
     if (messageTex)
     {
-        SDL_DestroyTexture(messageTex);
+        app->renderQueue->DestroyTexture(messageTex);
         messageTex = nullptr;
     }
-    if (imageTex)
-    {
-        SDL_DestroyTexture(imageTex);
-        imageTex = nullptr;
-    }
-    if (music)
-    {
-        Mix_FreeMusic(music);
-        music = nullptr;
-    }
-    if (moveSound)
-    {
-        Mix_FreeChunk(moveSound);
-        moveSound = nullptr;
-    }
-    if (enterSound)
-    {
-        Mix_FreeChunk(enterSound);
-        enterSound = nullptr;
-    }
+    sprites.Clear();
+    ReleaseTexture(imageTex);
+    ReleaseSound(moveSound);
+    ReleaseSound(enterSound);
 }
 
 SDL_AppResult MainMenuScene::HandleEvent(SDL_Event *event)
@@ -198,90 +190,49 @@ void MainMenuScene::Update(float deltaTime)
 
 void MainMenuScene::Render()
 {
-    SDL_SetRenderDrawColor(app->renderer, 0x21, 0x21, 0x21, SDL_ALPHA_OPAQUE);
-    SDL_RenderClear(app->renderer);
-
-    int targetWidth, targetHeight;
-    if (imageTex)
-    {
-        SDL_GetCurrentRenderOutputSize(app->renderer, &targetWidth, &targetHeight);
-    }
+    core::render::CommandBuffer &commands = app->renderQueue->Recording();
 
-    // Relación de aspecto de la imagen (8:3)
-    const float aspectRatio = 8.0f / 3.0f;
+    commands.SetDrawColor(0x21, 0x21, 0x21, SDL_ALPHA_OPAQUE);
+    commands.Clear();
 
-    float drawWidth, drawHeight;
-
-    // Si la pantalla es más alta que ancha, limitamos el ancho a la mitad del total
-    if (targetHeight > targetWidth)
-    {
-        drawWidth = targetWidth * 0.5f;
-        drawHeight = drawWidth / aspectRatio;
-    }
-    else
-    {
-        // Si es más ancha que alta, limitamos el alto a la mitad del total
-        drawHeight = targetHeight * 0.45f;
-        drawWidth = drawHeight * aspectRatio;
-    }
-
-    // Calcular coordenadas para centrar
-    float dstX = (targetWidth - drawWidth) / 2.0f;
-    float dstY = (targetHeight - drawHeight) * 0.125f;
-
-    SDL_FRect dstRect = {
-        dstX,
-        dstY,
-        drawWidth,
-        drawHeight};
-
-    SDL_RenderTexture(app->renderer, imageTex, nullptr, &dstRect);
+    sprites.Render(commands, app->outputWidth, app->outputHeight);
 
     if (messageTex)
-        SDL_RenderTexture(app->renderer, messageTex, nullptr, &messageDest);
+        commands.Texture(messageTex, nullptr, &messageDest);
 
     if (app->context)
     {
         app->context->Update();
         // app->render_interface->BeginFrame();
-        app->context->Render();
+        if (app->software_interface)
+            app->software_interface->RenderContext(app->context);
+        else
+            app->render_interface->RenderContext(app->context);
         // app->render_interface->EndFrame();
     }
-
-    SDL_RenderPresent(app->renderer);
 }
 
 // Utility loaders
 
 bool MainMenuScene::LoadImageTexture(const std::string &path)
 {
-    SDL_Surface *surface = IMG_Load(path.c_str());
-    if (!surface)
-    {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load image: %s", SDL_GetError());
-        return false;
-    }
-
-    imageTex = SDL_CreateTextureFromSurface(app->renderer, surface);
-    SDL_DestroySurface(surface);
-
-    if (!imageTex)
-    {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create image texture: %s", SDL_GetError());
+    imageTex = app->textures->LoadVariants(path, sceneName);
+    if (imageTex == core::render::INVALID_TEXTURE)
         return false;
-    }
 
+    // Logo 8:3, centrado arriba: ocupa el 45% del alto, sin pasar del 90% del ancho.
+    sprites.Add({.texture = imageTex,
+                 .anchorY = 0.07f,
+                 .pivot = core::utils::image::Pivot::TopCenter,
+                 .widthRatio = 0.9f,
+                 .heightRatio = 0.45f,
+                 .aspectRatio = 8.0f / 3.0f});
     return true;
 }
 
 bool MainMenuScene::LoadMusic(const std::string &path)
 {
-    music = Mix_LoadMUS(path.c_str());
-    if (!music)
-    {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load music: %s", SDL_GetError());
-        return false;
-    }
-    // Mix_PlayMusic(music, 0);
+    // The music player opens and decodes the file on its own thread when it starts playing.
+    musicPath = path;
     return true;
 }
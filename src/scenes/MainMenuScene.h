@@ -2,8 +2,8 @@
 #define SCENES_MAIN_MENU_SCENE_H
 
 #include "core/scene/Scene.h"
+#include "core/scene/SpriteLayer.h"
 #include "game/Mode.h"
-#include <SDL3_mixer/SDL_mixer.h>
 #include <RmlUi/Core/ElementDocument.h>
 #include <RmlUi/Core/EventListener.h> // <-- Necesario si usas custom EventListener
 
@@ -43,6 +43,7 @@ public:
 
     // Lifecycle
     bool Init() override;
+    void Prefetch() override;
     void Ready() override;
     void OnEnter() override;
     void OnExit() override;
@@ -52,13 +53,15 @@ public:
     SDL_AppResult HandleEvent(SDL_Event *event) override;
     void Update(float deltaTime) override;
     void Render() override;
-    Mix_Chunk *moveSound{nullptr};
-    Mix_Chunk *enterSound{nullptr};
+    void PlaySound(core::audio::SoundId sound) { app->sfx->Play(sound); }
+    core::audio::SoundId moveSound{core::audio::INVALID_SOUND};
+    core::audio::SoundId enterSound{core::audio::INVALID_SOUND};
 
 private:
     SDL_Texture *messageTex{nullptr};
-    SDL_Texture *imageTex{nullptr};
-    Mix_Music *music{nullptr};
+    core::render::TextureId imageTex{core::render::INVALID_TEXTURE};
+    core::scene::SpriteLayer sprites;
+    std::string musicPath;
     SDL_FRect messageDest{};
     // RmlUi
     Rml::ElementDocument *doc{nullptr};
@@ -5,12 +5,11 @@
 #include "scenes/MainMenuScene.h"
 #include "scenes/GameScene.h"
 
-/// @brief This function initialices the Global SceneManager.
-/// It should be called once (and only once during runtime) in the SDL_AppInit function.
+/// @brief Registers the initial scenes and starts prefetching their assets.
+/// Called early in SDL_AppInit, so that the decoding overlaps the rest of the startup.
 /// @param screenManager
-/// @param app
-/// @return
-bool InitScreenManager(core::scene::Manager *screenManager, AppContext *app)
+/// @param app Needs the texture manager and the SVG cache.
+void RegisterScreens(core::scene::Manager *screenManager, AppContext *app)
 {
     // Register ALL of the subscene events, even if they should not be called yet.
     core::scene::events::RegisterCommonSceneEvents();
@@ -18,7 +17,16 @@ bool InitScreenManager(core::scene::Manager *screenManager, AppContext *app)
 
     screenManager->RegisterScene(std::make_unique<SplashScene>(app));
     screenManager->RegisterScene(std::make_unique<MainMenuScene>(app));
+    screenManager->PrefetchScenes();
+}
 
+/// @brief This function initialices the Global SceneManager.
+/// It should be called once (and only once during runtime) in the SDL_AppInit function, after RegisterScreens.
+/// @param screenManager
+/// @param app
+/// @return
+bool InitScreenManager(core::scene::Manager *screenManager, AppContext *app)
+{
     if (!screenManager->InitScenes())
     {
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Couldn't initialize initial scenes");
@@ -36,6 +44,7 @@ SDL_AppResult HandleScreenEvents(SDL_Event *event, core::scene::Manager *sceneMa
 {
     if (event->type == core::scene::events::SCENE_FINISHED)
     {
+        // Copied: the branches below destroy the scene that owns the name.
         const std::string currentScene = sceneManager->GetCurrentSceneName();
         if (currentScene == "Splash")
         {
@@ -1,29 +1,46 @@
-#include <SDL3_image/SDL_image.h>
 #include <SDL3/SDL_render.h>
 #include <filesystem>
-#include <cmath>
 
 #include "SplashScene.h"
 #include "core/scene/Events.h"
-#include "core/utils/image/Texture.h"
 
 SplashScene::SplashScene(AppContext *context)
-    : Scene("Splash", context) {}
+    : Scene("Splash", context), sprites(context->textures, context->svgs) {}
 
 SplashScene::~SplashScene()
 {
     CleanUp();
 }
 
-bool SplashScene::Init()
+static std::string GetLogoPath()
 {
     std::filesystem::path basePath = SDL_GetBasePath();
     if (basePath.empty())
     {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to get base path: %s", SDL_GetError());
-        return false;
+        return {};
+    }
+    return (basePath / "resources/logo.svg").string();
+}
+
+void SplashScene::Prefetch()
+{
+    // The first frame shows the logo, so it is rasterized while the rest of the app starts.
+    const std::string path = GetLogoPath();
+    if (!path.empty() && LoadImageTexture(path))
+    {
+        sprites.Prefetch(app->outputWidth, app->outputHeight);
+    }
+}
+
+bool SplashScene::Init()
+{
+    if (!logoPath.empty())
+    {
+        return true;
     }
-    return LoadImageTexture((basePath / "resources/logo.svg").string());
+    const std::string path = GetLogoPath();
+    return !path.empty() && LoadImageTexture(path);
 }
 
 void SplashScene::Ready()
@@ -40,26 +57,19 @@ static Uint32 SceneFinishedTimerCallback(void *userdata, SDL_TimerID timerID, Ui
 
 void SplashScene::RenderLogo(SDL_Renderer *renderer)
 {
-    // Clean background color
-    SDL_SetRenderDrawColor(app->renderer, 36, 18, 36, SDL_ALPHA_OPAQUE);
-    SDL_RenderClear(app->renderer);
-    
-    int targetWidth, targetHeight;
-    SDL_GetCurrentRenderOutputSize(app->renderer, &targetWidth, &targetHeight);
+    core::render::CommandBuffer &commands = app->renderQueue->Recording();
 
-    SDL_FRect dstRect = core::utils::image::GetImageRect(targetWidth, targetHeight, 0.5f, 0.5f);
-
-    SDL_RenderTexture(app->renderer, logoTexture, nullptr, &dstRect);
+    // Clean background color
+    commands.SetDrawColor(36, 18, 36, SDL_ALPHA_OPAQUE);
+    commands.Clear();
 
-    // Actualizar el rendering target
-    SDL_RenderPresent(app->renderer);
+    sprites.Render(commands, app->outputWidth, app->outputHeight);
 }
 
 void SplashScene::OnEnter()
 { // Solo renderizamos la textura si está cargada
-    if (logoTexture)
+    if (!logoPath.empty())
     {
-        RenderLogo(app->renderer);
         // End scene after timer
         SDL_AddTimer(200, SceneFinishedTimerCallback, nullptr);
     }
@@ -67,14 +77,6 @@ void SplashScene::OnEnter()
 
 SDL_AppResult SplashScene::HandleEvent(SDL_Event *event)
 {
-    if (logoTexture)
-    {
-        if (event->type == SDL_EVENT_WINDOW_RESIZED)
-        {
-            RenderLogo(app->renderer);
-            return SDL_APP_CONTINUE;
-        }
-    }
     return SDL_APP_CONTINUE;
 }
 
@@ -84,6 +86,11 @@ void SplashScene::Update(float deltatime)
 
 void SplashScene::Render()
 {
+    // Redrawn every frame: the main loop presents after each Render
+    if (!logoPath.empty())
+    {
+        RenderLogo(app->renderer);
+    }
 }
 
 void SplashScene::OnExit()
@@ -92,30 +99,16 @@ void SplashScene::OnExit()
 
 void SplashScene::CleanUp()
 {
-    if (logoTexture)
-    {
-        SDL_DestroyTexture(logoTexture);
-        logoTexture = nullptr;
-    }
+    sprites.Clear();
+    logoPath.clear();
 }
 
 bool SplashScene::LoadImageTexture(const std::string &path)
 {
-    SDL_Surface *surface = IMG_Load(path.c_str());
-    if (!surface)
-    {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load image: %s", SDL_GetError());
-        return false;
-    }
-
-    logoTexture = SDL_CreateTextureFromSurface(app->renderer, surface);
-    SDL_DestroySurface(surface);
-
-    if (!logoTexture)
-    {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create image texture: %s", SDL_GetError());
+    if (!app->svgs->Load(path))
         return false;
-    }
-
+    logoPath = path;
+    // Rasterized at the size it covers on screen, so nothing is scaled once a resize settles.
+    sprites.Add({.svg = path, .widthRatio = 0.5f, .heightRatio = 0.5f});
     return true;
 }
\ No newline at end of file
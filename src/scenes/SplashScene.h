@@ -2,8 +2,8 @@
 #define SCENES_SPLASH_SCENE_H
 
 #include "core/scene/Scene.h"
+#include "core/scene/SpriteLayer.h"
 #include <SDL3/SDL.h>
-#include <SDL3_mixer/SDL_mixer.h>
 
 
 class SplashScene : public core::scene::Scene {
@@ -13,6 +13,7 @@ public:
 
     // Lifecycle
     bool Init() override;
+    void Prefetch() override;
     void Ready() override;
     void OnEnter() override;
     void OnExit() override;
@@ -24,7 +25,8 @@ public:
     void Render() override;
 
 private:
-    SDL_Texture* logoTexture{nullptr};
+    std::string logoPath; ///< SVG drawn through the shared raster cache.
+    core::scene::SpriteLayer sprites;
 
     bool LoadImageTexture(const std::string& path);
     void RenderLogo(SDL_Renderer *renderer);
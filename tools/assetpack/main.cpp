@@ -0,0 +1,126 @@
+// Packs asset directories into one archive that the game memory-maps at startup (see core/assets/PackFormat.h).
+// Files are named by their path relative to their <root>, e.g. "resources/ui/main_menu_screen.rml". Several
+// roots let build outputs, such as the textures cooked by texcook, sit beside the sources under the same names.
+//
+// Usage: assetpack <output> <root> <directory> [<root> <directory>]...
+
+#include "core/assets/PackFormat.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+namespace pack = core::assets::pack;
+
+struct File
+{
+    fs::path source;
+    std::string name;
+    pack::Entry entry{};
+};
+
+static void Pad(std::ofstream &out, std::uint64_t alignment)
+{
+    static const char zeros[pack::DATA_ALIGNMENT] = {};
+    const std::uint64_t position = static_cast<std::uint64_t>(out.tellp());
+    const std::uint64_t padding = (alignment - position % alignment) % alignment;
+    out.write(zeros, static_cast<std::streamsize>(padding));
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 4 || argc % 2 != 0)
+    {
+        std::fprintf(stderr, "usage: assetpack <output> <root> <directory> [<root> <directory>]...\n");
+        return 1;
+    }
+
+    const fs::path output = argv[1];
+    std::vector<File> files;
+    for (int i = 2; i < argc; i += 2)
+    {
+        const fs::path root = argv[i];
+        const fs::path directory = root / argv[i + 1];
+        std::error_code error;
+        for (fs::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+        {
+            if (!it->is_regular_file())
+                continue;
+            File file;
+            file.source = it->path();
+            file.name = it->path().lexically_relative(root).generic_string();
+            file.entry.hash = pack::HashName(file.name);
+            files.push_back(std::move(file));
+        }
+        if (error)
+        {
+            std::fprintf(stderr, "assetpack: couldn't read %s: %s\n", directory.string().c_str(), error.message().c_str());
+            return 1;
+        }
+    }
+
+    // The runtime binary-searches the index by hash.
+    std::sort(files.begin(), files.end(), [](const File &a, const File &b)
+              { return a.entry.hash != b.entry.hash ? a.entry.hash < b.entry.hash : a.name < b.name; });
+
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        std::fprintf(stderr, "assetpack: couldn't create %s\n", output.string().c_str());
+        return 1;
+    }
+
+    pack::Header header{};
+    std::copy(std::begin(pack::MAGIC), std::end(pack::MAGIC), header.magic);
+    header.version = pack::VERSION;
+    header.entryCount = static_cast<std::uint32_t>(files.size());
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    std::string names;
+    std::uint64_t dataBytes = 0;
+    for (File &file : files)
+    {
+        std::ifstream in(file.source, std::ios::binary);
+        if (!in)
+        {
+            std::fprintf(stderr, "assetpack: couldn't read %s\n", file.source.string().c_str());
+            return 1;
+        }
+        const std::vector<char> contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        Pad(out, pack::DATA_ALIGNMENT);
+        file.entry.offset = static_cast<std::uint64_t>(out.tellp());
+        file.entry.size = contents.size();
+        file.entry.nameOffset = static_cast<std::uint32_t>(names.size());
+        file.entry.nameLength = static_cast<std::uint32_t>(file.name.size());
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        names += file.name;
+        dataBytes += contents.size();
+    }
+
+    Pad(out, alignof(pack::Entry));
+    header.indexOffset = static_cast<std::uint64_t>(out.tellp());
+    for (const File &file : files)
+        out.write(reinterpret_cast<const char *>(&file.entry), sizeof(file.entry));
+
+    header.namesOffset = static_cast<std::uint64_t>(out.tellp());
+    header.namesSize = names.size();
+    out.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    if (!out)
+    {
+        std::fprintf(stderr, "assetpack: couldn't write %s\n", output.string().c_str());
+        return 1;
+    }
+
+    std::printf("assetpack: %zu files, %llu bytes of data -> %s\n", files.size(), static_cast<unsigned long long>(dataBytes),
+                output.string().c_str());
+    return 0;
+}
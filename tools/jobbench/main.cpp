@@ -0,0 +1,111 @@
+// Measures how core::jobs::Scheduler scales from one core to all of them, with two workloads:
+// a ParallelFor over a large array (the shape of the rasterizer and of batch updates), and a job
+// graph where every job of a stage depends on the whole previous stage (fan-out, then join).
+//
+// Usage: jobbench [max cores] [iterations]
+
+#include <SDL3/SDL.h>
+
+#include "core/jobs/Scheduler.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/// A few hundred nanoseconds of arithmetic that the compiler can't fold away.
+static float Work(float x)
+{
+    for (int i = 0; i < 16; i++)
+        x = std::sqrt(x * x + 1.0f) * 0.5f + std::sin(x);
+    return x;
+}
+
+static void RunParallelFor(core::jobs::Scheduler &jobs, std::vector<float> &values)
+{
+    jobs.ParallelFor(0, values.size(), 4096, [&values](size_t first, size_t last)
+                     {
+                         for (size_t i = first; i < last; i++)
+                             values[i] = Work(values[i]);
+                     });
+}
+
+static void RunGraph(core::jobs::Scheduler &jobs, std::vector<float> &values)
+{
+    constexpr int STAGES = 4;
+    constexpr int JOBS_PER_STAGE = 64;
+    const size_t slice = values.size() / JOBS_PER_STAGE;
+
+    // Counters don't move: every stage waits on the previous one's.
+    std::vector<core::jobs::Counter> stages(STAGES);
+    for (int stage = 0; stage < STAGES; stage++)
+    {
+        for (int job = 0; job < JOBS_PER_STAGE; job++)
+        {
+            core::jobs::Job body = [&values, first = job * slice, slice]
+            {
+                for (size_t i = first; i < first + slice; i++)
+                    values[i] = Work(values[i]);
+            };
+            if (stage == 0)
+                jobs.Run(std::move(body), &stages[stage]);
+            else
+                jobs.RunAfter(stages[stage - 1], std::move(body), &stages[stage]);
+        }
+    }
+    jobs.Wait(stages.back());
+}
+
+static double MeasureMs(core::jobs::Scheduler &jobs, void (*run)(core::jobs::Scheduler &, std::vector<float> &),
+                        std::vector<float> &values, int iterations)
+{
+    // One warm-up round so that the workers are awake and the array is in memory.
+    run(jobs, values);
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < iterations; i++)
+        run(jobs, values);
+    const Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+    return 1000.0 * static_cast<double>(elapsed) / static_cast<double>(SDL_GetPerformanceFrequency()) / iterations;
+}
+
+int main(int argc, char **argv)
+{
+    const int maxCores = argc > 1 ? std::atoi(argv[1]) : SDL_GetNumLogicalCPUCores();
+    const int iterations = argc > 2 ? std::atoi(argv[2]) : 10;
+    if (maxCores <= 0 || iterations <= 0)
+    {
+        std::fprintf(stderr, "usage: jobbench [max cores] [iterations]\n");
+        return 1;
+    }
+
+    if (!SDL_Init(0))
+    {
+        std::fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    std::vector<float> values(1 << 20);
+    for (size_t i = 0; i < values.size(); i++)
+        values[i] = static_cast<float>(i % 1000) * 0.001f;
+
+    std::printf("%zu items, %d iterations, %d logical cores\n", values.size(), iterations, SDL_GetNumLogicalCPUCores());
+    std::printf("%-6s %14s %8s %14s %8s %10s\n", "cores", "parallel for", "speedup", "job graph", "speedup", "stolen");
+    double baseFor = 0.0, baseGraph = 0.0;
+    for (int cores = 1; cores <= maxCores; cores++)
+    {
+        core::jobs::Scheduler jobs{cores - 1};
+        const double parallelFor = MeasureMs(jobs, RunParallelFor, values, iterations);
+        const double graph = MeasureMs(jobs, RunGraph, values, iterations);
+        if (cores == 1)
+        {
+            baseFor = parallelFor;
+            baseGraph = graph;
+        }
+        const core::jobs::Scheduler::Stats stats = jobs.GetStats();
+        std::printf("%-6d %11.3f ms %7.2fx %11.3f ms %7.2fx %9.1f%%\n", cores, parallelFor, baseFor / parallelFor, graph, baseGraph / graph,
+                    stats.executed ? 100.0 * stats.stolen / stats.executed : 0.0);
+    }
+
+    SDL_Quit();
+    return 0;
+}
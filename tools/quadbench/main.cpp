@@ -0,0 +1,249 @@
+// Compares the ways RenderInterface_SDL can draw axis-aligned UI quads on the software renderer:
+// one SDL_RenderGeometry call per quad (the general path), all quads in a single geometry batch,
+// the rect paths (SDL_RenderFillRect / SDL_RenderTexture) used by the quad fast path, and
+// core::render::SoftwareRasterizer followed by a single texture upload, as RenderInterface_Software does.
+//
+// Usage: quadbench [quads] [frames]
+
+#include <SDL3/SDL.h>
+
+#include "core/jobs/Scheduler.h"
+#include "core/render/SoftwareRasterizer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+struct Quad
+{
+    SDL_FRect rect;
+    SDL_FRect source;
+    Uint8 color[4];
+};
+
+struct Scene
+{
+    SDL_Renderer *renderer;
+    SDL_Texture *atlas;
+    SDL_BlendMode blendMode;
+    std::vector<Quad> quads;
+    bool textured;
+
+    core::render::SoftwareRasterizer *rasterizer;
+    core::render::SoftwareRasterizer::Texture atlasPixels;
+    SDL_Texture *output;
+};
+
+static void AppendQuad(const Quad &quad, std::vector<SDL_Vertex> &vertices, std::vector<int> &indices)
+{
+    const int first = static_cast<int>(vertices.size());
+    const SDL_FColor color = {quad.color[0] / 255.f, quad.color[1] / 255.f, quad.color[2] / 255.f, quad.color[3] / 255.f};
+    const float u0 = quad.source.x / 256.f, v0 = quad.source.y / 256.f;
+    const float u1 = (quad.source.x + quad.source.w) / 256.f, v1 = (quad.source.y + quad.source.h) / 256.f;
+    const SDL_FRect &r = quad.rect;
+
+    vertices.push_back({{r.x, r.y}, color, {u0, v0}});
+    vertices.push_back({{r.x + r.w, r.y}, color, {u1, v0}});
+    vertices.push_back({{r.x + r.w, r.y + r.h}, color, {u1, v1}});
+    vertices.push_back({{r.x, r.y + r.h}, color, {u0, v1}});
+    for (int index : {0, 3, 1, 1, 3, 2})
+        indices.push_back(first + index);
+}
+
+static void DrawGeometryPerQuad(const Scene &scene)
+{
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    for (const Quad &quad : scene.quads)
+    {
+        vertices.clear();
+        indices.clear();
+        AppendQuad(quad, vertices, indices);
+        SDL_RenderGeometry(scene.renderer, scene.textured ? scene.atlas : nullptr, vertices.data(), 4, indices.data(), 6);
+    }
+}
+
+static void DrawGeometryBatch(const Scene &scene)
+{
+    static std::vector<SDL_Vertex> vertices;
+    static std::vector<int> indices;
+    vertices.clear();
+    indices.clear();
+    for (const Quad &quad : scene.quads)
+        AppendQuad(quad, vertices, indices);
+    SDL_RenderGeometry(scene.renderer, scene.textured ? scene.atlas : nullptr, vertices.data(), static_cast<int>(vertices.size()),
+                       indices.data(), static_cast<int>(indices.size()));
+}
+
+static void DrawRects(const Scene &scene)
+{
+    for (const Quad &quad : scene.quads)
+    {
+        if (scene.textured)
+        {
+            SDL_SetTextureColorMod(scene.atlas, quad.color[0], quad.color[1], quad.color[2]);
+            SDL_SetTextureAlphaMod(scene.atlas, quad.color[3]);
+            SDL_RenderTexture(scene.renderer, scene.atlas, &quad.source, &quad.rect);
+        }
+        else
+        {
+            SDL_SetRenderDrawColor(scene.renderer, quad.color[0], quad.color[1], quad.color[2], quad.color[3]);
+            SDL_RenderFillRect(scene.renderer, &quad.rect);
+        }
+    }
+    SDL_SetTextureColorMod(scene.atlas, 255, 255, 255);
+    SDL_SetTextureAlphaMod(scene.atlas, 255);
+}
+
+static void DrawRasterized(const Scene &scene)
+{
+    static std::vector<core::render::SoftwareRasterizer::Vertex> vertices;
+    static std::vector<int> indices;
+    vertices.clear();
+    indices.clear();
+    for (const Quad &quad : scene.quads)
+    {
+        const int first = static_cast<int>(vertices.size());
+        core::render::SoftwareRasterizer::Pixel color;
+        SDL_memcpy(&color, quad.color, sizeof(color));
+        const float u0 = quad.source.x / 256.f, v0 = quad.source.y / 256.f;
+        const float u1 = (quad.source.x + quad.source.w) / 256.f, v1 = (quad.source.y + quad.source.h) / 256.f;
+        const SDL_FRect &r = quad.rect;
+
+        vertices.push_back({r.x, r.y, u0, v0, color});
+        vertices.push_back({r.x + r.w, r.y, u1, v0, color});
+        vertices.push_back({r.x + r.w, r.y + r.h, u1, v1, color});
+        vertices.push_back({r.x, r.y + r.h, u0, v1, color});
+        for (int index : {0, 3, 1, 1, 3, 2})
+            indices.push_back(first + index);
+    }
+
+    scene.rasterizer->Begin(1280, 720);
+    scene.rasterizer->DrawTriangles(vertices.data(), static_cast<int>(vertices.size()), indices.data(), static_cast<int>(indices.size()),
+                                    scene.textured ? &scene.atlasPixels : nullptr);
+    scene.rasterizer->Finish();
+    SDL_UpdateTexture(scene.output, nullptr, scene.rasterizer->GetPixels(), 1280 * sizeof(core::render::SoftwareRasterizer::Pixel));
+    SDL_RenderTexture(scene.renderer, scene.output, nullptr, nullptr);
+}
+
+static void RenderFrames(const Scene &scene, void (*draw)(const Scene &), int frames)
+{
+    for (int frame = 0; frame < frames; frame++)
+    {
+        SDL_SetRenderDrawColor(scene.renderer, 0, 0, 0, 255);
+        SDL_RenderClear(scene.renderer);
+        SDL_SetRenderDrawBlendMode(scene.renderer, scene.blendMode);
+        draw(scene);
+        SDL_FlushRenderer(scene.renderer);
+    }
+}
+
+static double MeasureMs(const Scene &scene, void (*draw)(const Scene &), int frames)
+{
+    // One warm-up frame so lazily created renderer state is not measured.
+    RenderFrames(scene, draw, 1);
+    const Uint64 start = SDL_GetPerformanceCounter();
+    RenderFrames(scene, draw, frames);
+    const Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+    return 1000.0 * static_cast<double>(elapsed) / static_cast<double>(SDL_GetPerformanceFrequency()) / frames;
+}
+
+int main(int argc, char **argv)
+{
+    const int quadCount = argc > 1 ? std::atoi(argv[1]) : 2000;
+    const int frames = argc > 2 ? std::atoi(argv[2]) : 60;
+    if (quadCount <= 0 || frames <= 0)
+    {
+        std::fprintf(stderr, "usage: quadbench [quads] [frames]\n");
+        return 1;
+    }
+
+    if (!SDL_Init(0))
+    {
+        std::fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Surface *surface = SDL_CreateSurface(1280, 720, SDL_PIXELFORMAT_RGBA32);
+    SDL_Renderer *renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    if (!renderer)
+    {
+        std::fprintf(stderr, "couldn't create the software renderer: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    // A checkerboard stands in for a glyph atlas, premultiplied like every RmlUi texture.
+    SDL_Surface *atlasSurface = SDL_CreateSurface(256, 256, SDL_PIXELFORMAT_RGBA32);
+    Uint32 *pixels = static_cast<Uint32 *>(atlasSurface->pixels);
+    for (int y = 0; y < 256; y++)
+        for (int x = 0; x < 256; x++)
+            pixels[y * (atlasSurface->pitch / 4) + x] = ((x / 8 + y / 8) & 1) ? 0xFFFFFFFF : 0x00000000;
+
+    Scene scene{};
+    scene.renderer = renderer;
+    scene.atlas = SDL_CreateTextureFromSurface(renderer, atlasSurface);
+    scene.atlasPixels.width = 256;
+    scene.atlasPixels.height = 256;
+    for (int y = 0; y < 256; y++)
+        scene.atlasPixels.pixels.insert(scene.atlasPixels.pixels.end(), pixels + y * (atlasSurface->pitch / 4), pixels + y * (atlasSurface->pitch / 4) + 256);
+    SDL_DestroySurface(atlasSurface);
+    // The software renderer rejects custom blend modes, so this is the predefined mode the UI uses there.
+    scene.blendMode = SDL_BLENDMODE_BLEND_PREMULTIPLIED;
+
+    core::jobs::Scheduler jobs;
+    core::render::SoftwareRasterizer rasterizer;
+    rasterizer.SetScheduler(&jobs);
+    scene.rasterizer = &rasterizer;
+    scene.output = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, 1280, 720);
+
+    // A rejected blend mode would leave the default straight-alpha blending, and measure another path.
+    if (!SDL_SetTextureBlendMode(scene.atlas, scene.blendMode) || !SDL_SetTextureBlendMode(scene.output, scene.blendMode) ||
+        !SDL_SetRenderDrawBlendMode(renderer, scene.blendMode))
+    {
+        std::fprintf(stderr, "couldn't set the premultiplied blend mode: %s\n", SDL_GetError());
+        SDL_DestroyTexture(scene.output);
+        SDL_DestroyTexture(scene.atlas);
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroySurface(surface);
+        SDL_Quit();
+        return 1;
+    }
+
+    // Mostly small quads, like glyphs and borders, with a few larger backgrounds.
+    SDL_srand(1);
+    scene.quads.resize(quadCount);
+    for (Quad &quad : scene.quads)
+    {
+        const bool large = SDL_rand(10) == 0;
+        const float w = static_cast<float>(large ? 64 + SDL_rand(256) : 4 + SDL_rand(16));
+        const float h = static_cast<float>(large ? 32 + SDL_rand(128) : 8 + SDL_rand(16));
+        quad.rect = {static_cast<float>(SDL_rand(1280 - static_cast<int>(w))), static_cast<float>(SDL_rand(720 - static_cast<int>(h))), w, h};
+        quad.source = {static_cast<float>(SDL_rand(256 - 32)), static_cast<float>(SDL_rand(256 - 32)), 16.f, 16.f};
+        const Uint8 alpha = static_cast<Uint8>(128 + SDL_rand(128));
+        for (int c = 0; c < 3; c++)
+            quad.color[c] = static_cast<Uint8>(SDL_rand(256) * alpha / 255);
+        quad.color[3] = alpha;
+    }
+
+    std::printf("%d quads, %d frames, 1280x720 software renderer\n", quadCount, frames);
+    std::printf("%-10s %14s %14s %14s %14s\n", "", "geometry/quad", "geometry batch", "rects", "rasterizer");
+    for (bool textured : {false, true})
+    {
+        scene.textured = textured;
+        const double perQuad = MeasureMs(scene, DrawGeometryPerQuad, frames);
+        const double batch = MeasureMs(scene, DrawGeometryBatch, frames);
+        const double rects = MeasureMs(scene, DrawRects, frames);
+        const double rasterized = MeasureMs(scene, DrawRasterized, frames);
+        std::printf("%-10s %11.3f ms %11.3f ms %11.3f ms %11.3f ms\n", textured ? "textured" : "solid", perQuad, batch, rects, rasterized);
+    }
+
+    std::printf("rasterizer: %d threads\n", rasterizer.GetStats().threads);
+
+    SDL_DestroyTexture(scene.output);
+    SDL_DestroyTexture(scene.atlas);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+    SDL_Quit();
+    return 0;
+}
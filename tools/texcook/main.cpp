@@ -0,0 +1,93 @@
+// Cooks an image into a texture the game uploads without decoding it (see core/assets/TextureFormat.h): decodes it
+// with SDL_image, converts it to RGBA32 and premultiplies the alpha, exactly as the renderers would at load time.
+// SVGs are rasterized at their intrinsic size, like IMG_Load() does.
+//
+// Usage: texcook <input> <output>
+
+#include "core/assets/TextureFormat.h"
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace fs = std::filesystem;
+namespace texture = core::assets::texture;
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        std::fprintf(stderr, "usage: texcook <input> <output>\n");
+        return 1;
+    }
+
+    const fs::path input = argv[1];
+    const fs::path output = argv[2];
+
+    SDL_Surface *surface = IMG_Load(input.string().c_str());
+    if (!surface)
+    {
+        std::fprintf(stderr, "texcook: couldn't decode %s: %s\n", input.string().c_str(), SDL_GetError());
+        return 1;
+    }
+    if (surface->format != SDL_PIXELFORMAT_RGBA32)
+    {
+        SDL_Surface *converted = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(surface);
+        if (!converted)
+        {
+            std::fprintf(stderr, "texcook: couldn't convert %s: %s\n", input.string().c_str(), SDL_GetError());
+            return 1;
+        }
+        surface = converted;
+    }
+
+    texture::Header header{};
+    std::copy(std::begin(texture::MAGIC), std::end(texture::MAGIC), header.magic);
+    header.version = texture::VERSION;
+    header.width = static_cast<std::uint32_t>(surface->w);
+    header.height = static_cast<std::uint32_t>(surface->h);
+    header.format = SDL_PIXELFORMAT_RGBA32;
+    header.pitch = header.width * 4;
+    header.dataOffset = texture::DATA_ALIGNMENT;
+
+    std::vector<std::uint8_t> pixels(static_cast<size_t>(header.pitch) * header.height);
+    for (int y = 0; y < surface->h; y++)
+    {
+        const std::uint8_t *row = static_cast<const std::uint8_t *>(surface->pixels) + static_cast<size_t>(y) * surface->pitch;
+        std::uint8_t *destination = pixels.data() + static_cast<size_t>(y) * header.pitch;
+        for (std::uint32_t x = 0; x < header.pitch; x += 4)
+        {
+            const std::uint8_t alpha = row[x + 3];
+            for (int j = 0; j < 3; ++j)
+                destination[x + j] = static_cast<std::uint8_t>(int(row[x + j]) * int(alpha) / 255);
+            destination[x + 3] = alpha;
+        }
+    }
+    SDL_DestroySurface(surface);
+
+    std::error_code error;
+    fs::create_directories(output.parent_path(), error);
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        std::fprintf(stderr, "texcook: couldn't create %s\n", output.string().c_str());
+        return 1;
+    }
+
+    static const char zeros[texture::DATA_ALIGNMENT] = {};
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(zeros, static_cast<std::streamsize>(header.dataOffset - sizeof(header)));
+    out.write(reinterpret_cast<const char *>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+    if (!out)
+    {
+        std::fprintf(stderr, "texcook: couldn't write %s\n", output.string().c_str());
+        return 1;
+    }
+    return 0;
+}